@@ -2,7 +2,10 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map> // For catalog hash indexes
 #include <queue>
+#include <deque> // For ticketed consultation queues
+#include <list> // For the route cache recency order
 #include <stack>
 #include <set> // For BST (optional, can be custom BST)
 #include <algorithm> // For sorting & searching
@@ -10,6 +13,39 @@
 #include <chrono> // For time
 #include <ctime> // For time
 #include <limits> // For numeric_limits
+#include <atomic> // For lock-free book availability
+#include <mutex> // For per-mentor and per-student locks
+#include <condition_variable> // For WAL group commit
+#include <thread> // For the concurrency benchmark
+#include <memory> // For unique_ptr
+#include <fstream> // For batch command files
+#include <sstream> // For parsing batch commands
+#include <streambuf> // For the terminal frame buffer
+#include <initializer_list> // For table layouts
+#include <cerrno> // For EINTR
+#include <cstdio> // For fwrite on Windows
+#ifndef _WIN32
+#include <unistd.h> // For write() and _exit()
+#include <fcntl.h> // For open() and non-blocking sockets
+#include <sys/mman.h> // For memory-mapped snapshots
+#include <sys/stat.h> // For mkdir() and file sizes
+#include <sys/resource.h> // For peak memory in benchmarks
+#endif
+#ifdef __linux__
+#include <csignal> // For stopping the server cleanly
+#include <sys/epoll.h> // For the server event loop
+#include <sys/socket.h> // For Unix domain sockets
+#include <sys/un.h> // For sockaddr_un
+#endif
+#include <random> // For benchmark data generators
+#include <cstdint> // For uint64_t
+#include <cstring> // For memcmp
+#include <cstdlib> // For strtoull and strtod
+#include <cmath> // For isfinite
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // For SSE2/AVX2 title search kernels
+#endif
+#include <new> // For placement new (LinkedList arena)
 
 using namespace std; // Using namespace std to avoid writing std::
 
@@ -17,6 +53,25 @@ using namespace std; // Using namespace std to avoid writing std::
 //           STRUCTURES AND CLASSES (DEFINED FIRST)
 // ===============================================
 
+// A mentor's week of consultation sessions: start times within the day, each with the number of
+// students it takes, held on the weekdays set in `hari` (bit 0 = Monday ... bit 6 = Sunday)
+struct PolaJadwal {
+    struct Sesi {
+        uint16_t menit; // Minutes after local midnight
+        uint16_t kapasitas;
+    };
+    vector<Sesi> sesi = {{9 * 60, 4}, {10 * 60, 4}, {11 * 60, 4}, {13 * 60, 4}, {14 * 60, 4}, {15 * 60, 4}};
+    uint8_t hari = 0x1F; // Monday to Friday
+
+    uint32_t kapasitasMingguan() const {
+        uint32_t perHari = 0;
+        for (const Sesi& s : sesi) perHari += s.kapasitas;
+        uint32_t jumlahHari = 0;
+        for (int h = 0; h < 7; h++) jumlahHari += (hari >> h) & 1;
+        return perHari * jumlahHari;
+    }
+};
+
 // Data for Dosen (newly added)
 struct Dosen {
     string id;
@@ -24,822 +79,7841 @@ struct Dosen {
     string mata_kuliah;
 };
 
-// Data for Books
+// Data for Books (immutable catalog entry; loan state lives in KatalogBuku's availability bitmap)
 struct Buku {
     string id;
     string judul;
     string dosen_referensi;
-    bool tersedia;
 
-    // For sorting and searching (required by std::set)
+    // Catalog order is by title
     bool operator<(const Buku& other) const {
         return judul < other.judul;
     }
 };
 
-// Data for Consultation
-struct Konsultasi {
-    int no_urut; // Sequential number for display in queue
-    string nama_mahasiswa;
-    string nim_mahasiswa; // Add NIM for unique identification
-    string tanggal_daftar;
-    string nama_dosen;
-};
+// Result view over the catalog: slot numbers of matching books in title order.
+// Search, filter and display pass these around instead of copying Buku objects.
+struct BukuView {
+    vector<size_t> slots;
 
-// 1. Linked List - For Loan History and Activity
-// Node for Linked List
-template <typename T>
-struct Node {
-    T data;
-    Node* next;
-    Node(T val) : data(val), next(nullptr) {}
+    bool empty() const { return slots.empty(); }
+    size_t size() const { return slots.size(); }
+    vector<size_t>::const_iterator begin() const { return slots.begin(); }
+    vector<size_t>::const_iterator end() const { return slots.end(); }
 };
 
-// Simple Linked List Class
-template <typename T>
-class LinkedList {
+// Clock Service - Epoch timestamps for storage, "dd-mm-yyyy" local dates for display.
+// Every thread caches the bounds of the last local day it formatted and that day's string, so
+// formatting a time inside it is a range check and a copy. localtime_r (no shared static tm) and
+// mktime only run when the day rolls over or an older entry from another day is shown.
+class LayananWaktu {
 private:
-    Node<T>* head;
-public:
-    LinkedList() : head(nullptr) {}
+    struct CacheHari {
+        int64_t awal = 0; // [awal, akhir) in Unix seconds; empty until the first call
+        int64_t akhir = 0;
+        string teks;
+    };
 
-    // Destructor to free memory
-    ~LinkedList() {
-        Node<T>* current = head;
-        while (current != nullptr) {
-            Node<T>* next = current->next;
-            delete current;
-            current = next;
-        }
-        head = nullptr;
+    static CacheHari& cache() {
+        thread_local CacheHari c;
+        return c;
     }
 
-    void add(T val) {
-        Node<T>* newNode = new Node<T>(val);
-        if (head == nullptr) {
-            head = newNode;
-        } else {
-            Node<T>* current = head;
-            while (current->next != nullptr) {
-                current = current->next;
-            }
-            current->next = newNode;
+    static void isiCache(CacheHari& c, int64_t waktu) {
+        time_t detik = static_cast<time_t>(waktu);
+        tm lokal;
+#ifdef _WIN32
+        localtime_s(&lokal, &detik);
+#else
+        localtime_r(&detik, &lokal);
+#endif
+        char teks[40];
+        snprintf(teks, sizeof(teks), "%02d-%02d-%04d", lokal.tm_mday, lokal.tm_mon + 1, 1900 + lokal.tm_year);
+        c.teks = teks;
+
+        lokal.tm_hour = lokal.tm_min = lokal.tm_sec = 0;
+        lokal.tm_isdst = -1; // Let mktime resolve DST for midnight
+        c.awal = static_cast<int64_t>(mktime(&lokal));
+        lokal.tm_mday++;
+        lokal.tm_isdst = -1;
+        c.akhir = static_cast<int64_t>(mktime(&lokal));
+        if (c.awal > waktu || c.akhir <= waktu) { // mktime failed: cache this second only
+            c.awal = waktu;
+            c.akhir = waktu + 1;
         }
     }
 
-    Node<T>* getHead() const {
-        return head;
+public:
+    // Current Unix time in seconds (what history entries and log records store)
+    static int64_t sekarang() {
+        return chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
     }
 
-    bool isEmpty() const {
-        return head == nullptr;
+    // Local date of a Unix time as "dd-mm-yyyy" (fits in the small-string buffer, so no allocation)
+    static string tanggal(int64_t waktu) {
+        CacheHari& c = cache();
+        if (waktu < c.awal || waktu >= c.akhir) isiCache(c, waktu);
+        return c.teks;
     }
-};
 
-// Data for Student
-struct Mahasiswa {
-    string nim;
-    string password;
-    string nama;
-    LinkedList<pair<string, string>> riwayat_peminjaman; // <Date, Book Title>
-    LinkedList<pair<string, string>> riwayat_aktivitas; // <Date, Activity Description>
-    bool sudah_daftar_konsultasi; // Indicates if student has registered for consultation
-    string dosen_konsultasi_terdaftar; // Stores the mentor's name if registered
-    
-    // Default constructor
-    Mahasiswa() : sudah_daftar_konsultasi(false), dosen_konsultasi_terdaftar("") {}
+    // Offset of local time from UTC in seconds, read once. Consultation sessions are laid out on
+    // local days of exactly 24 hours from it.
+    static int64_t zona() {
+        static const int64_t offset = [] {
+            time_t detik = time(nullptr);
+            tm utc;
+#ifdef _WIN32
+            gmtime_s(&utc, &detik);
+#else
+            gmtime_r(&detik, &utc);
+#endif
+            utc.tm_isdst = -1;
+            return static_cast<int64_t>(detik) - static_cast<int64_t>(mktime(&utc));
+        }();
+        return offset;
+    }
 
-    // Parameterized constructor for initial student setup
-    Mahasiswa(string n, string p, string nm)
-        : nim(n), password(p), nama(nm),
-          sudah_daftar_konsultasi(false), 
-          dosen_konsultasi_terdaftar("") {}
-};
+    // Local time of day of a Unix time as "HH:MM"
+    static string jam(int64_t waktu) {
+        int64_t detik = ((waktu + zona()) % 86400 + 86400) % 86400;
+        char teks[16];
+        snprintf(teks, sizeof(teks), "%02d:%02d", static_cast<int>(detik / 3600), static_cast<int>(detik / 60 % 60));
+        return teks;
+    }
 
+    // "dd-mm-yyyy HH:MM" of a consultation session, on the fixed-offset days sessions are laid out
+    // on. Pure arithmetic: a queue spans many days, which would keep missing tanggal()'s cache.
+    static string tanggalJam(int64_t waktu) {
+        int64_t lokal = waktu + zona();
+        int64_t hari = lokal >= 0 ? lokal / 86400 : -((-lokal + 86399) / 86400);
+        int64_t detik = lokal - hari * 86400;
+        // Civil date of a day count (March-based years, as in dariTanggal)
+        hari += 719468;
+        int64_t era = (hari >= 0 ? hari : hari - 146096) / 146097;
+        int64_t hariEra = hari - era * 146097;
+        int64_t tahunEra = (hariEra - hariEra / 1460 + hariEra / 36524 - hariEra / 146096) / 365;
+        int64_t hariTahun = hariEra - (365 * tahunEra + tahunEra / 4 - tahunEra / 100);
+        int64_t bulanMaret = (5 * hariTahun + 2) / 153;
+        int d = static_cast<int>(hariTahun - (153 * bulanMaret + 2) / 5 + 1);
+        int m = static_cast<int>(bulanMaret < 10 ? bulanMaret + 3 : bulanMaret - 9);
+        int y = static_cast<int>(tahunEra + era * 400 + (m <= 2 ? 1 : 0));
+        char teks[40];
+        snprintf(teks, sizeof(teks), "%02d-%02d-%04d %02d:%02d", d, m, y, static_cast<int>(detik / 3600), static_cast<int>(detik / 60 % 60));
+        return teks;
+    }
 
-// ===============================================
-//           GLOBAL DATA AND POINTERS (DECLARED AFTER STRUCTS/CLASSES)
-// ===============================================
+    // Start of the local day written as "dd-mm-yyyy", or -1 if the text is not such a date
+    static int64_t dariTanggal(const string& teks) {
+        int d = 0, m = 0, y = 0;
+        char lebih;
+        if (sscanf(teks.c_str(), "%d-%d-%d%c", &d, &m, &y, &lebih) != 3 || y < 1970 || y > 9999 || m < 1 || m > 12) return -1;
+        static const int HARI_BULAN[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool kabisat = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+        if (d < 1 || d > HARI_BULAN[m - 1] + (m == 2 && kabisat ? 1 : 0)) return -1;
+        // Days since 01-01-1970 of a civil date (March-based years put the leap day last)
+        int64_t tahun = y - (m <= 2 ? 1 : 0);
+        int64_t era = tahun / 400;
+        int64_t tahunEra = tahun - era * 400;
+        int64_t hariTahun = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        int64_t hariEra = tahunEra * 365 + tahunEra / 4 - tahunEra / 100 + hariTahun;
+        return (era * 146097 + hariEra - 719468) * 86400 - zona();
+    }
+};
 
-// Global constants
-const string KAMPUS_CAKRAWALA = "Universitas Cakrawala";
+// Data for Consultation
+struct Konsultasi {
+    int no_urut = 0; // Sequential number for display in queue
+    string nama_mahasiswa;
+    string nim_mahasiswa; // Add NIM for unique identification
+    string tanggal_daftar;
+    string nama_dosen;
+    int64_t jadwal = 0; // Start of the booked session (Unix seconds)
+};
 
-// Global container for Dosen data
-map<string, Dosen> dataDosen; // Key: ID Dosen, Value: Dosen Object
+// 2. Segment Tree - Time-slot Schedule for Academic Consultation
+// Every session of every day is a leaf holding the students booked into it, in booking order.
+// Inner nodes keep the most seats left and the number of bookings below them, so the earliest
+// session after a given time with a free seat, a student's position (bookings in earlier
+// sessions plus their rank inside their own) and the front of the line are each one walk of the
+// tree, O(log n) in the sessions. Cancelling or moving a booking updates one or two leaves in
+// place; a NIM -> session index finds the booking. The tree covers a window of local days that
+// grows (doubling) as bookings reach its end, or moves back if an earlier day is asked for
+// (replay). majukan() slides it forward past days that have ended and retires their bookings.
+class JadwalKonsultasi {
+public:
+    static const int64_t TIDAK_ADA = -1;
+    static const int64_t DETIK_SEHARI = 86400;
 
-// 2. Queue - For Academic Consultation Queue (Two separate queues per mentor)
-queue<Konsultasi> antreanIdrusMadani;
-queue<Konsultasi> antreanDwiWulan;
+    // Local day number (days since 01-01-1970) of a Unix time
+    static int64_t hariDari(int64_t waktu) {
+        int64_t lokal = waktu + LayananWaktu::zona();
+        return lokal >= 0 ? lokal / DETIK_SEHARI : -((-lokal + DETIK_SEHARI - 1) / DETIK_SEHARI);
+    }
 
-// 4. Hash Table - For Student Login (using map as simulation)
-map<string, Mahasiswa> dataMahasiswa; // Key: NIM, Value: Mahasiswa Object
+private:
+    static const size_t TIDAK_ADA_SESI = static_cast<size_t>(-1);
 
-// 5. Tree (BST) - For Library Book List (using set as BST simulation)
-set<Buku> daftarBuku; // Will be automatically sorted based on operator< in Buku struct
+    PolaJadwal pola;
+    int64_t hariPertama = 0; // Local day number (days since 01-01-1970) of the window's first day
+    size_t jumlahHari = 0;
+    size_t daun = 0;          // Leaves in the tree: a power of two >= jumlahHari * sessions
+    vector<uint32_t> sisaMaks; // Nodes 1 .. 2*daun-1: most seats left in a session below
+    vector<uint32_t> terisi;   // Same nodes: bookings below
+    vector<vector<Konsultasi>> isi; // Bookings of each session of the window
+    unordered_map<string, size_t> sesiByNim;
+    size_t jumlah = 0;
+    int nomorBerikut = 1;
 
-// 6. Graph - For Campus Navigation (simple static routes)
-map<string, vector<string>> ruteKampus; // Key: Station Name, Value: Vector of route steps
+    size_t sesiPerHari() const { return pola.sesi.size(); }
 
-// Global variable to store current logged-in user
-Mahasiswa* currentUser = nullptr;
+    int64_t waktuSesi(size_t i) const {
+        int64_t hari = hariPertama + static_cast<int64_t>(i / sesiPerHari());
+        return hari * DETIK_SEHARI - LayananWaktu::zona() + pola.sesi[i % sesiPerHari()].menit * 60;
+    }
 
+    uint32_t kapasitas(size_t i) const {
+        int64_t hari = hariPertama + static_cast<int64_t>(i / sesiPerHari());
+        int hariMinggu = static_cast<int>(((hari + 3) % 7 + 7) % 7); // 01-01-1970 was a Thursday
+        return (pola.hari >> hariMinggu) & 1 ? pola.sesi[i % sesiPerHari()].kapasitas : 0;
+    }
 
-// ===============================================
-//           FORWARD DECLARATIONS OF FUNCTIONS
-// ===============================================
+    void perbarui(size_t i) {
+        size_t p = daun + i;
+        uint32_t n = static_cast<uint32_t>(isi[i].size());
+        uint32_t kap = kapasitas(i);
+        sisaMaks[p] = kap > n ? kap - n : 0;
+        terisi[p] = n;
+        for (p >>= 1; p > 0; p >>= 1) {
+            sisaMaks[p] = max(sisaMaks[2 * p], sisaMaks[2 * p + 1]);
+            terisi[p] = terisi[2 * p] + terisi[2 * p + 1];
+        }
+    }
 
-// Utility functions
-void clearScreen();
-string getCurrentDate();
-void pressEnterToContinue();
-void displayHeader();
+    // Rebuilds the tree over `hari` days from local day `awal`. Bookings on days before `awal`
+    // are moved to `lewat` (the window slides forward); every other booking is kept.
+    void aturJendela(int64_t awal, size_t hari, vector<Konsultasi>* lewat = nullptr) {
+        // Old session i becomes session i + geser; there is nothing to carry over on the first build
+        int64_t geser = jumlahHari == 0 ? 0 : (hariPertama - awal) * static_cast<int64_t>(sesiPerHari());
+        vector<vector<Konsultasi>> lama;
+        lama.swap(isi);
+        hariPertama = awal;
+        jumlahHari = hari;
+        isi.resize(jumlahHari * sesiPerHari());
+        daun = 1;
+        while (daun < isi.size()) daun <<= 1;
+        sisaMaks.assign(2 * daun, 0);
+        terisi.assign(2 * daun, 0);
+        for (size_t i = 0; i < lama.size(); i++) {
+            if (lama[i].empty()) continue;
+            int64_t baru = static_cast<int64_t>(i) + geser;
+            if (baru >= 0) {
+                isi[static_cast<size_t>(baru)] = std::move(lama[i]);
+                continue;
+            }
+            for (Konsultasi& k : lama[i]) {
+                sesiByNim.erase(k.nim_mahasiswa);
+                jumlah--;
+                if (lewat != nullptr) lewat->push_back(std::move(k));
+            }
+        }
+        for (size_t i = 0; i < isi.size(); i++) {
+            sisaMaks[daun + i] = kapasitas(i) > isi[i].size() ? kapasitas(i) - static_cast<uint32_t>(isi[i].size()) : 0;
+            terisi[daun + i] = static_cast<uint32_t>(isi[i].size());
+        }
+        for (size_t p = daun - 1; p > 0; p--) {
+            sisaMaks[p] = max(sisaMaks[2 * p], sisaMaks[2 * p + 1]);
+            terisi[p] = terisi[2 * p] + terisi[2 * p + 1];
+        }
+        if (geser != 0) {
+            for (auto& entri : sesiByNim) entri.second = static_cast<size_t>(static_cast<int64_t>(entri.second) + geser);
+        }
+    }
 
-// UI functions (formerly in ConsoleUI)
-void displayLoginMenu();
-void displayMainMenu();
-void KonsultasiAkademikMenu();
-void PerpustakaanMenu();
-void RiwayatPeminjamanMenu();
-void RiwayatAktivitasMenu();
-void NavigasiKampusMenu();
+    // First session starting after `dari`, growing the window back to its day if needed
+    size_t sesiSetelah(int64_t dari) {
+        int64_t hari = hariDari(dari);
+        if (jumlahHari == 0) aturJendela(hari, 14);
+        else if (hari < hariPertama) aturJendela(hari, jumlahHari + static_cast<size_t>(hariPertama - hari));
+        int64_t detik = dari + LayananWaktu::zona() - hari * DETIK_SEHARI;
+        size_t k = 0;
+        while (k < sesiPerHari() && pola.sesi[k].menit * 60 <= detik) k++;
+        return static_cast<size_t>(hari - hariPertama) * sesiPerHari() + k;
+    }
 
-// Service-related helper functions (formerly in Services/*.h)
-void initializeData(); // Formerly in DataInitializer
-void displayBooksTable(const set<Buku>& bukuList); // Formerly in LibraryService
-void borrowBook(const string& bookId, const string& dosenRujukan); // Formerly in LibraryService
-set<Buku> searchBooks(const string& keyword, const string& dosenRujukan); // Formerly in LibraryService
-set<Buku> filterAvailableBooks(const string& dosenRujukan); // Formerly in LibraryService
+    // Leftmost session at or after `dari` with a seat left in node p covering [l, r)
+    size_t cariBebas(size_t p, size_t l, size_t r, size_t dari) const {
+        if (r <= dari || sisaMaks[p] == 0) return TIDAK_ADA_SESI;
+        if (r - l == 1) return l;
+        size_t tengah = (l + r) / 2;
+        size_t hasil = cariBebas(2 * p, l, tengah, dari);
+        return hasil != TIDAK_ADA_SESI ? hasil : cariBebas(2 * p + 1, tengah, r, dari);
+    }
 
-// New/modified consultation service functions
-void registerConsultationLogic(string idDosen); // Simplified logic after ID is validated
-void displayDetailedConsultationQueue(const string& nim_mahasiswa); // Displays table and user's status
+    // Bookings in the sessions before session i
+    size_t terisiSebelum(size_t i) const {
+        size_t total = 0;
+        for (size_t l = daun, r = daun + i; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) total += terisi[l++];
+            if (r & 1) total += terisi[--r];
+        }
+        return total;
+    }
 
-void displayRoute(const string& stationName); // Formerly in CampusNavigationService
+    int64_t tempatkan(Konsultasi k, int64_t dari) {
+        size_t i = sesiSetelah(dari);
+        size_t j;
+        while ((j = cariBebas(1, 0, daun, i)) == TIDAK_ADA_SESI) {
+            aturJendela(hariPertama, max<size_t>(jumlahHari * 2, (i / sesiPerHari()) + 7)); // A new week always has a seat
+        }
+        k.jadwal = waktuSesi(j);
+        sesiByNim[k.nim_mahasiswa] = j;
+        isi[j].push_back(std::move(k));
+        perbarui(j);
+        jumlah++;
+        return waktuSesi(j);
+    }
 
-// ===============================================
-//           UTILITY FUNCTIONS
-// ===============================================
+public:
+    explicit JadwalKonsultasi(const PolaJadwal& p = PolaJadwal()) : pola(p) {}
 
-void clearScreen() {
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
-}
+    // Books the student into the earliest session starting after `dari` that has a seat left and
+    // returns its start time; TIDAK_ADA if the mentor holds no sessions. Replaces a booking the
+    // student already has with this mentor.
+    int64_t pesan(Konsultasi k, int64_t dari) {
+        if (pola.kapasitasMingguan() == 0) return TIDAK_ADA;
+        batal(k.nim_mahasiswa);
+        k.no_urut = nomorBerikut++;
+        return tempatkan(std::move(k), dari);
+    }
 
-string getCurrentDate() {
-    auto now = chrono::system_clock::now();
-    time_t now_c = chrono::system_clock::to_time_t(now);
-    tm* ltm = localtime(&now_c);
+    // Books exactly the session starting at `waktu` (a saved booking), or the next one with a seat
+    int64_t pesanPada(Konsultasi k, int64_t waktu) {
+        return pesan(std::move(k), waktu - 1);
+    }
 
-    string year = to_string(1900 + ltm->tm_year);
-    string month = to_string(1 + ltm->tm_mon);
-    string day = to_string(ltm->tm_mday);
+    // Removes the student's booking; false if they have none
+    bool batal(const string& nim) {
+        auto it = sesiByNim.find(nim);
+        if (it == sesiByNim.end()) return false;
+        size_t i = it->second;
+        sesiByNim.erase(it);
+        vector<Konsultasi>& sesi = isi[i];
+        for (size_t j = 0; j < sesi.size(); j++) {
+            if (sesi[j].nim_mahasiswa == nim) {
+                sesi.erase(sesi.begin() + static_cast<ptrdiff_t>(j));
+                break;
+            }
+        }
+        perbarui(i);
+        jumlah--;
+        return true;
+    }
 
-    if (month.length() == 1) month = "0" + month;
-    if (day.length() == 1) day = "0" + day;
+    // Moves the student's booking to the earliest session after `dari` with a seat left (their
+    // own seat counts as free) and returns its start time; TIDAK_ADA if they have no booking.
+    // When that is the session they already hold, they keep their place in it.
+    int64_t pindah(const string& nim, int64_t dari) {
+        if (sesiByNim.find(nim) == sesiByNim.end()) return TIDAK_ADA;
+        size_t i = sesiSetelah(dari); // May rebuild the window, so look the booking up after it
+        auto it = sesiByNim.find(nim);
+        if (it->second >= i) {
+            size_t j = cariBebas(1, 0, daun, i);
+            if (j == TIDAK_ADA_SESI || it->second <= j) return waktuSesi(it->second);
+        }
+        Konsultasi k;
+        for (const Konsultasi& entri : isi[it->second]) {
+            if (entri.nim_mahasiswa == nim) k = entri;
+        }
+        batal(nim);
+        return tempatkan(std::move(k), dari);
+    }
 
-    return day + "-" + month + "-" + year;
-}
+    // Retires every booking on a local day before the one of `sekarang` into `lewat` and moves the
+    // window's start to that day, so neither the tree nor positions keep counting past days
+    void majukan(int64_t sekarang, vector<Konsultasi>& lewat) {
+        int64_t hari = hariDari(sekarang);
+        if (jumlahHari == 0 || hari <= hariPertama) return;
+        size_t maju = static_cast<size_t>(hari - hariPertama);
+        aturJendela(hari, maju < jumlahHari ? max<size_t>(jumlahHari - maju, 14) : 14, &lewat);
+    }
 
-void pressEnterToContinue() {
-    cout << "   Silahkan tekan 'Enter' untuk melanjutkan...";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer before getting new input
-    cin.get();
-}
+    // Removes the first booking in session order into `hasil`; false if there are none
+    bool selesai(Konsultasi& hasil) {
+        if (jumlah == 0) return false;
+        size_t p = 1;
+        while (p < daun) p = terisi[2 * p] > 0 ? 2 * p : 2 * p + 1;
+        hasil = isi[p - daun].front();
+        batal(hasil.nim_mahasiswa);
+        return true;
+    }
 
-void displayHeader() {
-    cout << "============================================================================================\n";
-    cout << "  _____ ___ ___   ____  ____  ______   _____ ______  __ __  ___      ___  ____   ______ \n";
-    cout << " / ___/|   |   | /    ||    \\|      | / ___/|      ||  |  ||   \\    /  _]|    \\ |      |\n";
-    cout << "(   \\_ | _   _ ||  o  ||  D  )      |(   \\_ |      ||  |  ||    \\  /  [_ |  _  ||      |\n";
-    cout << " \\__  ||  \\_/  ||     ||    /|_|  |_| \\__  ||_|  |_||  |  ||  D  ||    _]|  |  ||_|  |_|\n";
-    cout << " /  \\ ||   |   ||  _  ||    \\  |  | __/  \\ |  |  |  |  :  ||     ||   [_ |  |  |  |  |  \n";
-    cout << " \\    ||   |   ||  |  ||  .  \\ |  ||  \\    |  |  |  |     ||     ||     ||  |  |  |  |  \n";
-    cout << "  \\___||___|___||__|__||__|\\_| |__||__|\\___|  |__|   \\__,_||_____||_____||__|__|  |__|  \n";
-    cout << "\n";
-    cout << "                                     CAKRAWALA UNIVERSITY                                    \n";
-    cout << "============================================================================================\n";
-    cout << "\n";
-}
+    // 1-based position of the student among all bookings in session order, or 0 if not booked;
+    // `jadwal` receives the start of their session
+    size_t posisi(const string& nim, int64_t& jadwal) const {
+        jadwal = TIDAK_ADA;
+        auto it = sesiByNim.find(nim);
+        if (it == sesiByNim.end()) return 0;
+        size_t i = it->second;
+        size_t urutan = 1;
+        while (isi[i][urutan - 1].nim_mahasiswa != nim) urutan++;
+        jadwal = waktuSesi(i);
+        return terisiSebelum(i) + urutan;
+    }
 
-// ===============================================
-//           DATA INITIALIZATION FUNCTION
-// ===============================================
+    size_t posisi(const string& nim) const {
+        int64_t jadwal;
+        return posisi(nim, jadwal);
+    }
 
-void initializeData() {
-    // Data Mahasiswa (Hash Table)
-    dataMahasiswa["217403"] = Mahasiswa("217403", "15071999", "Aulia Putri");
-    dataMahasiswa["532618"] = Mahasiswa("532618", "03082002", "Rafi Akbar");
-    dataMahasiswa["894205"] = Mahasiswa("894205", "22121997", "Laras Wulan");
-    dataMahasiswa["670349"] = Mahasiswa("670349", "09052000", "Dito Pratama");
-    dataMahasiswa["356127"] = Mahasiswa("356127", "17111998", "Sinta Devi");
+    // Calls f(booking) for every booking in session order
+    template <typename F>
+    void untukSetiap(F&& f) const {
+        for (const vector<Konsultasi>& sesi : isi) {
+            for (const Konsultasi& k : sesi) f(k);
+        }
+    }
 
-    // Data Dosen (newly added)
-    dataDosen["DSN1"] = {"DSN1", "Idrus Madani", "Data Structures"};
-    dataDosen["DSN2"] = {"DSN2", "Dwi Wulan", "Algoritma dan Pemrograman"};
+    const PolaJadwal& polaJadwal() const { return pola; }
+    bool empty() const { return jumlah == 0; }
+    size_t size() const { return jumlah; }
+};
 
-    // Book Data (BST represented by std::set)
-    daftarBuku.insert({"A1B2", "Pengantar Python untuk Pemula", dataDosen["DSN1"].nama, true});
-    daftarBuku.insert({"C3D4", "Desain Web Responsif dengan HTML & CSS", dataDosen["DSN1"].nama, true});
-    daftarBuku.insert({"E5F6", "Struktur Data dan Algoritma dalam Java", dataDosen["DSN1"].nama, true});
-    daftarBuku.insert({"G7H8", "Prinsip Desain UI/UX Modern", dataDosen["DSN1"].nama, true});
-    daftarBuku.insert({"I9J0", "Pengembangan Aplikasi Android dengan Kotlin", dataDosen["DSN1"].nama, true});
-
-    daftarBuku.insert({"K1L2", "Seni Desain Grafis Digital", dataDosen["DSN2"].nama, true});
-    daftarBuku.insert({"M3N4", "Basis Data SQL untuk Pengembang", dataDosen["DSN2"].nama, true});
-    daftarBuku.insert({"O5P6", "Desain Interaksi Pengguna", dataDosen["DSN2"].nama, true});
-    daftarBuku.insert({"Q7R8", "Pengantar Machine Learning dengan Python", dataDosen["DSN2"].nama, true});
-    daftarBuku.insert({"S9T0", "Tipografi dalam Desain Grafis", dataDosen["DSN2"].nama, true});
-
-    // Campus Navigation Routes (Static Routes)
-    ruteKampus["Tebet"] = {
-        "Tebet",
-        "Jl. Raya Kasablanka",
-        "Jl. H. Rasuna Said",
-        "Jl. Mampang Prapatan",
-        "Jl. Kemang Utara",
-        "Jl. Kemang Timur (" + KAMPUS_CAKRAWALA + ")"
-    };
-    ruteKampus["Blok M"] = {
-        "Blok M",
-        "Jl. Melawai Raya",
-        "Jl. Prapanca Raya",
-        "Jl. Kemang Raya",
-        "Jl. Kemang Selatan",
-        "Jl. Kemang Timur (" + KAMPUS_CAKRAWALA + ")"
-    };
-    ruteKampus["Lb. Bulus"] = {
-        "Lebak Bulus",
-        "Jl. RS. Fatmawati Raya",
-        "Jl. TB Simatupang",
-        "Jl. Ampera Raya",
-        "Jl. Kemang Timur (" + KAMPUS_CAKRAWALA + ")"
-    };
-    ruteKampus["Tanjung Barat"] = {
-        "Tanjung Barat",
-        "Jl. TB Simatupang",
-        "Jl. Ampera Raya",
-        "Jl. Kemang Timur (" + KAMPUS_CAKRAWALA + ")"
-    };
-    ruteKampus["Taman Mini"] = {
-        "Taman Mini",
-        "Jl. Keong Mas",
-        "Jl. Raya Mabes Hankam",
-        "Jl. TB Simatupang",
-        "Jl. Ampera Raya",
-        "Jl. Kemang Timur (" + KAMPUS_CAKRAWALA + ")"
+// Mentor Registry - Interned mentor IDs mapped to their consultation queues
+// Each mentor gets a dense ID on registration; the mentor's data and queue live at that index.
+// Lookups by code ("DSN1") or name are hash lookups that never insert, and dosenByNim records
+// which queue a student is in, so registration, position lookup and dequeue are O(1)
+// however many mentors there are.
+// Thread safety: mentors are registered at startup, before any concurrent use. After that every
+// mentor queue has its own mutex, and the NIM -> mentor index is split into independently locked
+// shards, so students queueing for different mentors never contend. Lock order is shard, then queue.
+class RegistriDosen {
+private:
+    struct AntreanDosen {
+        mutable mutex kunci;
+        JadwalKonsultasi antrean;
+
+        explicit AntreanDosen(const PolaJadwal& pola) : antrean(pola) {}
     };
-}
 
-// ===============================================
-//           AUTHENTICATION SERVICE FUNCTIONS
-// ===============================================
+    struct ShardNim {
+        mutable mutex kunci;
+        unordered_map<string, uint32_t> dosenByNim; // NIM -> mentor whose schedule the student is in
+    };
+    static const size_t JUMLAH_SHARD = 64;
 
-void loginUser(string nim, string password) {
-    auto it = dataMahasiswa.find(nim);
-    if (it != dataMahasiswa.end() && it->second.password == password) {
-        currentUser = &(it->second);
-    } else {
-        currentUser = nullptr; // Ensure currentUser is null on failed login
-    }
-}
+    vector<Dosen> dosen;                        // Indexed by interned mentor ID
+    vector<unique_ptr<AntreanDosen>> antrean;   // Schedule of each mentor, same index
+    unordered_map<string, uint32_t> idByKode;   // "DSN1" -> mentor ID
+    unordered_map<string, uint32_t> idByNama;   // "Idrus Madani" -> mentor ID
+    ShardNim shard[JUMLAH_SHARD];
+    atomic<int64_t> hariDimajukan{numeric_limits<int64_t>::min()}; // Local day majukan() last ran for
 
-// ===============================================
-//           CONSULTATION SERVICE FUNCTIONS
-// ===============================================
+    ShardNim& shardUntuk(const string& nim) { return shard[hash<string>()(nim) % JUMLAH_SHARD]; }
+    const ShardNim& shardUntuk(const string& nim) const { return shard[hash<string>()(nim) % JUMLAH_SHARD]; }
 
-// Helper function to display a specific queue table
-void displayQueueTableInternal(queue<Konsultasi> q_copy) { // Pass by value to work on a copy
-    cout << string(92, '-') << endl;
-    cout << left << setw(5) << "No."
-              << setw(20) << "Nama Mahasiswa"
-              << setw(20) << "Tanggal Daftar"
-              << setw(30) << "Nama Dosen" << endl;
-    cout << string(92, '-') << endl;
+public:
+    static const uint32_t NOT_FOUND = static_cast<uint32_t>(-1);
 
-    int no_display = 1;
-    while (!q_copy.empty()) {
-        Konsultasi k = q_copy.front();
-        cout << left << setw(5) << no_display++
-                  << setw(20) << k.nama_mahasiswa
-                  << setw(20) << k.tanggal_daftar
-                  << setw(30) << k.nama_dosen << endl;
-        q_copy.pop();
+    // Registers a mentor with their week of sessions and returns its ID (the existing ID if the
+    // code is already registered)
+    uint32_t add(const Dosen& d, const PolaJadwal& pola = PolaJadwal()) {
+        auto it = idByKode.find(d.id);
+        if (it != idByKode.end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(dosen.size());
+        dosen.push_back(d);
+        antrean.emplace_back(new AntreanDosen(pola));
+        idByKode[d.id] = id;
+        idByNama.emplace(d.nama, id);
+        return id;
     }
-    cout << endl;
-}
 
-// Function to register consultation based on Dosen ID
-void registerConsultationLogic(string idDosen) {
-    if (dataDosen.count(idDosen)) {
-        string namaDosen = dataDosen[idDosen].nama;
-        Konsultasi newKonsultasi;
-        newKonsultasi.nama_mahasiswa = currentUser->nama;
-        newKonsultasi.nim_mahasiswa = currentUser->nim;
-        newKonsultasi.tanggal_daftar = getCurrentDate();
-        newKonsultasi.nama_dosen = namaDosen;
-
-        if (namaDosen == dataDosen["DSN1"].nama) { // "Idrus Madani"
-            antreanIdrusMadani.push(newKonsultasi);
-        } else if (namaDosen == dataDosen["DSN2"].nama) { // "Dwi Wulan"
-            antreanDwiWulan.push(newKonsultasi);
-        }
-
-        currentUser->riwayat_aktivitas.add({getCurrentDate(), "Mendaftar konsultasi akademik dengan " + namaDosen});
-        currentUser->sudah_daftar_konsultasi = true;
-        currentUser->dosen_konsultasi_terdaftar = namaDosen;
-        cout << "\n   " << currentUser->nama << " telah berhasil mendaftarkan konsultasi dengan " << namaDosen << ".\n";
-    } else {
-        cout << "\n   ID Dosen tidak ditemukan. Pendaftaran gagal.\n";
+    uint32_t findByKode(const string& kode) const {
+        auto it = idByKode.find(kode);
+        return it == idByKode.end() ? NOT_FOUND : it->second;
     }
-    pressEnterToContinue();
-}
 
-// Displays queue for the user's chosen mentor or general message if not registered
-void displayDetailedConsultationQueue(const string& nim_mahasiswa) {
-    bool userInQueue = false;
-    int userQueueNumber = 0;
-    string dosenTerdaftar = "";
-
-    // Check Idrus Madani's queue
-    queue<Konsultasi> tempQueueIdrus = antreanIdrusMadani; // Make a copy
-    int currentQueuePos = 1;
-    while (!tempQueueIdrus.empty()) {
-        if (tempQueueIdrus.front().nim_mahasiswa == nim_mahasiswa) {
-            userInQueue = true;
-            userQueueNumber = currentQueuePos;
-            dosenTerdaftar = dataDosen["DSN1"].nama; // Use dataDosen map for consistency
-            break;
-        }
-        tempQueueIdrus.pop();
-        currentQueuePos++;
+    uint32_t findByNama(const string& nama) const {
+        auto it = idByNama.find(nama);
+        return it == idByNama.end() ? NOT_FOUND : it->second;
     }
 
-    // If not found, check Dwi Wulan's queue
-    if (!userInQueue) {
-        queue<Konsultasi> tempQueueDwi = antreanDwiWulan; // Make a copy
-        currentQueuePos = 1; 
-        while (!tempQueueDwi.empty()) {
-            if (tempQueueDwi.front().nim_mahasiswa == nim_mahasiswa) {
-                userInQueue = true;
-                userQueueNumber = currentQueuePos;
-                dosenTerdaftar = dataDosen["DSN2"].nama; // Use dataDosen map for consistency
-                break;
-            }
-            tempQueueDwi.pop();
-            currentQueuePos++;
-        }
+    const Dosen& at(uint32_t id) const { return dosen[id]; }
+    const PolaJadwal& polaJadwal(uint32_t id) const { return antrean[id]->antrean.polaJadwal(); } // Fixed once added
+    size_t size() const { return dosen.size(); }
+    vector<Dosen>::const_iterator begin() const { return dosen.begin(); }
+    vector<Dosen>::const_iterator end() const { return dosen.end(); }
+
+    // Runs `baca` on the mentor's schedule while holding its lock (e.g. to render the table)
+    template <typename F>
+    void bacaAntrean(uint32_t id, F baca) const {
+        lock_guard<mutex> lock(antrean[id]->kunci);
+        baca(antrean[id]->antrean);
     }
 
-    // Update status in currentUser if found in queue but not set
-    if (userInQueue && !currentUser->sudah_daftar_konsultasi) {
-        currentUser->sudah_daftar_konsultasi = true;
-        currentUser->dosen_konsultasi_terdaftar = dosenTerdaftar;
+    size_t ukuranAntrean(uint32_t id) const {
+        lock_guard<mutex> lock(antrean[id]->kunci);
+        return antrean[id]->antrean.size();
     }
 
-    if (userInQueue) {
-        if (dosenTerdaftar == dataDosen["DSN1"].nama) {
-            displayQueueTableInternal(antreanIdrusMadani); 
-        } else if (dosenTerdaftar == dataDosen["DSN2"].nama) {
-            displayQueueTableInternal(antreanDwiWulan); 
+    // Books a registration into the mentor's earliest session after `dari` with a seat left and
+    // returns the session's start (JadwalKonsultasi::TIDAK_ADA if the mentor holds none, in which
+    // case any booking the student already has is kept).
+    // `tepat`: `dari` is the start of a saved booking's session, which is kept if it has a seat.
+    int64_t daftar(uint32_t id, Konsultasi k, int64_t dari, bool tepat = false) {
+        ShardNim& s = shardUntuk(k.nim_mahasiswa);
+        lock_guard<mutex> lock(s.kunci);
+        string nim = k.nim_mahasiswa;
+        int64_t jadwal;
+        {
+            lock_guard<mutex> lockAntrean(antrean[id]->kunci);
+            jadwal = tepat ? antrean[id]->antrean.pesanPada(std::move(k), dari) : antrean[id]->antrean.pesan(std::move(k), dari);
         }
-
-        cout << "   Anda terdaftar dalam antrean : [" << userQueueNumber << "]\n";
-        cout << "   Konsultasi dengan " << dosenTerdaftar << ".\n";
-        cout << "\n";
-        // pressEnterToContinue() will be called by ConsoleUI after this function returns
-    } else {
-        // This message is only shown if the user is NOT in queue and no other queue is displayed
-        // No table here, as per new requirement: "Belum ada antrean yang terdaftar." is handled in ConsoleUI if option 2 is chosen.
+        if (jadwal == JadwalKonsultasi::TIDAK_ADA) return jadwal;
+        uint32_t& dosenLama = s.dosenByNim.emplace(nim, id).first->second;
+        if (dosenLama != id) { // One booking per student: drop the one with the other mentor
+            lock_guard<mutex> lockLama(antrean[dosenLama]->kunci);
+            antrean[dosenLama]->antrean.batal(nim);
+            dosenLama = id;
+        }
+        return jadwal;
     }
-}
-
-// ===============================================
-//           LIBRARY SERVICE FUNCTIONS
-// ===============================================
 
-void displayBooksTable(const set<Buku>& bukuList) {
-    cout << string(92, '-') << endl;
-    cout << left << setw(10) << "ID"
-              << setw(50) << "Judul Buku"
-              << setw(15) << "Status" << endl;
-    cout << string(92, '-') << endl;
-    if (bukuList.empty()) {
-        cout << "Tidak ada buku untuk ditampilkan.\n";
-    } else {
-        for (const auto& buku : bukuList) {
-            cout << left << setw(10) << buku.id
-                      << setw(50) << buku.judul
-                      << setw(15) << (buku.tersedia ? "Tersedia" : "Tidak Tersedia") << endl;
-        }
+    // Cancels the student's booking; returns the mentor it was with, NOT_FOUND if none
+    uint32_t batal(const string& nim) {
+        ShardNim& s = shardUntuk(nim);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.dosenByNim.find(nim);
+        if (it == s.dosenByNim.end()) return NOT_FOUND;
+        uint32_t id = it->second;
+        s.dosenByNim.erase(it);
+        lock_guard<mutex> lockAntrean(antrean[id]->kunci);
+        antrean[id]->antrean.batal(nim);
+        return id;
     }
-    cout << endl;
-}
 
-void borrowBook(const string& bookId, const string& dosenRujukan) {
-    bool foundBook = false;
-    Buku tempBook; 
-
-    for (auto it = daftarBuku.begin(); it != daftarBuku.end(); ++it) {
-        if (it->id == bookId && it->dosen_referensi == dosenRujukan) {
-            if (it->tersedia) {
-                tempBook = *it; 
-                daftarBuku.erase(it); 
-                tempBook.tersedia = false; 
-                daftarBuku.insert(tempBook); 
-                
-                currentUser->riwayat_peminjaman.add({getCurrentDate(), tempBook.judul});
-                currentUser->riwayat_aktivitas.add({getCurrentDate(), "Meminjam buku dengan judul \"" + tempBook.judul + "\""});
+    // Moves the student's booking to their mentor's earliest session after `dari` with a seat
+    // left; returns the mentor (NOT_FOUND if the student has no booking), `jadwal` the new start
+    uint32_t pindah(const string& nim, int64_t dari, int64_t& jadwal) {
+        jadwal = JadwalKonsultasi::TIDAK_ADA;
+        ShardNim& s = shardUntuk(nim);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.dosenByNim.find(nim);
+        if (it == s.dosenByNim.end()) return NOT_FOUND;
+        uint32_t id = it->second;
+        lock_guard<mutex> lockAntrean(antrean[id]->kunci);
+        jadwal = antrean[id]->antrean.pindah(nim, dari);
+        return id;
+    }
 
-                cout << "\n   Buku \"" << tempBook.judul << "\" telah berhasil dipinjam.\n";
-                foundBook = true;
-            } else {
-                cout << "\n   Buku \"" << it->judul << "\" tidak tersedia (sudah dipinjam).\n";
-                foundBook = true;
+    // Removes the first booking in the mentor's schedule; returns false if there was none
+    bool selesai(uint32_t id) {
+        Konsultasi k;
+        {
+            lock_guard<mutex> lock(antrean[id]->kunci);
+            if (!antrean[id]->antrean.selesai(k)) {
+                return false;
             }
-            break;
         }
+        ShardNim& s = shardUntuk(k.nim_mahasiswa);
+        lock_guard<mutex> lockShard(s.kunci);
+        auto it = s.dosenByNim.find(k.nim_mahasiswa);
+        if (it != s.dosenByNim.end() && it->second == id) {
+            lock_guard<mutex> lockAntrean(antrean[id]->kunci);
+            if (antrean[id]->antrean.posisi(k.nim_mahasiswa) == 0) { // Not booked again in the meantime
+                s.dosenByNim.erase(it);
+            }
+        }
+        return true;
     }
-    if (!foundBook) {
-        cout << "\nID Buku tidak ditemukan atau bukan rujukan dosen ini.\n";
-    }
-    pressEnterToContinue();
-}
-
-set<Buku> searchBooks(const string& keyword, const string& dosenRujukan) {
-    set<Buku> searchResults;
-    for (const auto& buku : daftarBuku) {
-        if (buku.dosen_referensi == dosenRujukan) {
-            string judulLower = buku.judul;
-            string keywordLower = keyword;
-            transform(judulLower.begin(), judulLower.end(), judulLower.begin(), ::tolower);
-            transform(keywordLower.begin(), keywordLower.end(), keywordLower.begin(), ::tolower);
 
-            if (judulLower.find(keywordLower) != string::npos) {
-                searchResults.insert(buku);
+    // Retires the bookings on days that ended before the one of `sekarang` from every schedule
+    // and returns how many there were. Does nothing more than once a day.
+    size_t majukan(int64_t sekarang) {
+        size_t hasil = 0;
+        int64_t hari = JadwalKonsultasi::hariDari(sekarang);
+        if (hariDimajukan.exchange(hari) == hari) return hasil;
+        for (uint32_t id = 0; id < antrean.size(); id++) {
+            vector<Konsultasi> lewat;
+            {
+                lock_guard<mutex> lock(antrean[id]->kunci);
+                antrean[id]->antrean.majukan(sekarang, lewat);
+            }
+            for (const Konsultasi& k : lewat) {
+                ShardNim& s = shardUntuk(k.nim_mahasiswa);
+                lock_guard<mutex> lockShard(s.kunci);
+                auto it = s.dosenByNim.find(k.nim_mahasiswa);
+                if (it != s.dosenByNim.end() && it->second == id) {
+                    lock_guard<mutex> lockAntrean(antrean[id]->kunci);
+                    if (antrean[id]->antrean.posisi(k.nim_mahasiswa) == 0) { // Not booked again in the meantime
+                        s.dosenByNim.erase(it);
+                    }
+                }
+                hasil++;
             }
         }
+        return hasil;
     }
-    return searchResults;
-}
 
-set<Buku> filterAvailableBooks(const string& dosenRujukan) {
-    set<Buku> filteredResults;
-    for (const auto& buku : daftarBuku) {
-        if (buku.tersedia && buku.dosen_referensi == dosenRujukan) {
-            filteredResults.insert(buku);
+    // Mentor whose schedule the student is in (NOT_FOUND if none); `posisi` gets the 1-based
+    // position in session order and `jadwal` the start of the student's session
+    uint32_t cariAntrean(const string& nim, size_t& posisi, int64_t& jadwal) const {
+        posisi = 0;
+        jadwal = JadwalKonsultasi::TIDAK_ADA;
+        uint32_t id;
+        {
+            const ShardNim& s = shardUntuk(nim);
+            lock_guard<mutex> lock(s.kunci);
+            auto it = s.dosenByNim.find(nim);
+            if (it == s.dosenByNim.end()) {
+                return NOT_FOUND;
+            }
+            id = it->second;
         }
+        lock_guard<mutex> lock(antrean[id]->kunci);
+        posisi = antrean[id]->antrean.posisi(nim, jadwal);
+        return posisi > 0 ? id : NOT_FOUND;
     }
-    return filteredResults;
-}
+};
+
+// 1. Linked List - For Loan History and Activity
+// Node for Linked List
+template <typename T>
+struct Node {
+    T data;
+    Node* next;
+    Node(T val) : data(std::move(val)), next(nullptr) {}
+};
+
+// Append-only Linked List Class
+// Nodes are carved out of chunked arenas (each chunk twice the size of the previous one, up to a cap)
+// so consecutive entries sit next to each other in memory, and a tail pointer makes add() O(1).
+// Iteration stays the same: start at getHead() and follow next.
+template <typename T>
+class LinkedList {
+private:
+    static const size_t FIRST_CHUNK_NODES = 8;
+    static const size_t MAX_CHUNK_NODES = 4096;
+
+    Node<T>* head;
+    Node<T>* tail;
+    size_t count;
+    vector<Node<T>*> chunks; // Raw storage blocks owned by this list
+    size_t chunkUsed;        // Nodes constructed in the last chunk
+    size_t chunkCapacity;    // Capacity of the last chunk
+
+    Node<T>* allocateNode() {
+        if (chunks.empty() || chunkUsed == chunkCapacity) {
+            chunkCapacity = chunks.empty() ? FIRST_CHUNK_NODES : min(chunkCapacity * 2, MAX_CHUNK_NODES);
+            chunks.push_back(static_cast<Node<T>*>(::operator new(sizeof(Node<T>) * chunkCapacity)));
+            chunkUsed = 0;
+        }
+        return chunks.back() + chunkUsed++;
+    }
+
+    void release() {
+        Node<T>* current = head;
+        while (current != nullptr) {
+            Node<T>* next = current->next;
+            current->~Node<T>();
+            current = next;
+        }
+        for (Node<T>* chunk : chunks) {
+            ::operator delete(chunk);
+        }
+        chunks.clear();
+        head = tail = nullptr;
+        count = chunkUsed = chunkCapacity = 0;
+    }
+
+    void stealFrom(LinkedList& other) {
+        head = other.head;
+        tail = other.tail;
+        count = other.count;
+        chunks = std::move(other.chunks);
+        chunkUsed = other.chunkUsed;
+        chunkCapacity = other.chunkCapacity;
+        other.chunks.clear();
+        other.head = other.tail = nullptr;
+        other.count = other.chunkUsed = other.chunkCapacity = 0;
+    }
+
+public:
+    LinkedList() : head(nullptr), tail(nullptr), count(0), chunkUsed(0), chunkCapacity(0) {}
+
+    LinkedList(const LinkedList& other) : LinkedList() {
+        for (Node<T>* current = other.head; current != nullptr; current = current->next) {
+            add(current->data);
+        }
+    }
+
+    LinkedList(LinkedList&& other) noexcept : LinkedList() {
+        stealFrom(other);
+    }
+
+    LinkedList& operator=(const LinkedList& other) {
+        if (this != &other) {
+            LinkedList copy(other);
+            release();
+            stealFrom(copy);
+        }
+        return *this;
+    }
+
+    LinkedList& operator=(LinkedList&& other) noexcept {
+        if (this != &other) {
+            release();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    // Destructor to free memory
+    ~LinkedList() {
+        release();
+    }
+
+    void add(T val) {
+        Node<T>* newNode = new (allocateNode()) Node<T>(std::move(val));
+        if (tail == nullptr) {
+            head = newNode;
+        } else {
+            tail->next = newNode;
+        }
+        tail = newNode;
+        count++;
+    }
+
+    Node<T>* getHead() const {
+        return head;
+    }
+
+    bool isEmpty() const {
+        return head == nullptr;
+    }
+
+    size_t size() const {
+        return count;
+    }
+};
+
+template <typename T>
+const size_t LinkedList<T>::MAX_CHUNK_NODES; // Bound by reference in min()
+
+// Substring search kernels (used by KatalogBuku to scan its lowercased title arena)
+// All kernels share one signature: return the first position >= 0 where `needle` occurs in
+// `data`, or NOT_FOUND_POS. The SIMD versions use the first-and-last-byte filter: compare a block
+// starting at i with the needle's first byte and a block starting at i + m - 1 with its last byte,
+// and only run memcmp on positions where both match. The best one is picked once at runtime.
+const size_t NOT_FOUND_POS = static_cast<size_t>(-1);
+typedef size_t (*SubstringKernel)(const char* data, size_t n, const char* needle, size_t m);
+
+size_t findSubstringScalar(const char* data, size_t n, const char* needle, size_t m) {
+    if (m == 0) return 0;
+    if (m > n) return NOT_FOUND_POS;
+    for (size_t i = 0; i + m <= n; i++) {
+        if (data[i] == needle[0] && data[i + m - 1] == needle[m - 1] && memcmp(data + i, needle, m) == 0) {
+            return i;
+        }
+    }
+    return NOT_FOUND_POS;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SMARTSTUDENT_X86_KERNELS
+
+__attribute__((target("sse2")))
+size_t findSubstringSse2(const char* data, size_t n, const char* needle, size_t m) {
+    if (m == 0) return 0;
+    if (m > n) return NOT_FOUND_POS;
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst),
+                                                        _mm_cmpeq_epi8(last, blockLast)));
+        while (mask != 0) {
+            unsigned bit = __builtin_ctz(mask);
+            if (memcmp(data + i + bit, needle, m) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    size_t rest = findSubstringScalar(data + i, n - i, needle, m);
+    return rest == NOT_FOUND_POS ? NOT_FOUND_POS : i + rest;
+}
+
+__attribute__((target("avx2")))
+size_t findSubstringAvx2(const char* data, size_t n, const char* needle, size_t m) {
+    if (m == 0) return 0;
+    if (m > n) return NOT_FOUND_POS;
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + m - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+        while (mask != 0) {
+            unsigned bit = __builtin_ctz(mask);
+            if (memcmp(data + i + bit, needle, m) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    size_t rest = findSubstringSse2(data + i, n - i, needle, m);
+    return rest == NOT_FOUND_POS ? NOT_FOUND_POS : i + rest;
+}
+#endif
+
+// Picks the widest kernel the CPU supports
+SubstringKernel selectSubstringKernel(string* nama = nullptr) {
+#ifdef SMARTSTUDENT_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        if (nama) *nama = "avx2";
+        return findSubstringAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        if (nama) *nama = "sse2";
+        return findSubstringSse2;
+    }
+#endif
+    if (nama) *nama = "scalar";
+    return findSubstringScalar;
+}
+
+// Runs kerja(awal, akhir, t) on T threads over consecutive ranges of [0, n), one per core;
+// thread t gets [n * t / T, n * (t + 1) / T). Returns T.
+template <typename F>
+size_t jalankanParalel(size_t n, F kerja) {
+    size_t jumlahThread = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), (n + 4095) / 4096));
+    if (jumlahThread == 1) {
+        kerja(size_t(0), n, size_t(0));
+        return 1;
+    }
+    vector<thread> threads;
+    for (size_t t = 0; t < jumlahThread; t++) {
+        threads.emplace_back(kerja, n * t / jumlahThread, n * (t + 1) / jumlahThread, t);
+    }
+    for (thread& th : threads) th.join();
+    return jumlahThread;
+}
+
+// Open-addressing hash index from a string field of the catalog's books to their slots.
+// Entries are (hash, slot + 1) packed in one word: the table never copies a key, growing it never
+// re-reads the strings, and a probe only compares the key when the stored hash matches.
+class IndeksSlot {
+private:
+    vector<uint64_t> tabel; // 0 = empty
+    size_t jumlah;
+
+    void taruh(uint64_t entri) {
+        size_t mask = tabel.size() - 1;
+        for (size_t i = (entri >> 32) & mask;; i = (i + 1) & mask) {
+            if (tabel[i] == 0) {
+                tabel[i] = entri;
+                return;
+            }
+        }
+    }
+
+    void ubahKapasitas(size_t kapasitas) {
+        vector<uint64_t> lama(kapasitas, 0);
+        lama.swap(tabel);
+        for (uint64_t entri : lama) {
+            if (entri != 0) taruh(entri);
+        }
+    }
+
+public:
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    IndeksSlot() : jumlah(0) {}
+
+    static uint32_t hashKunci(const string& kunci) { return static_cast<uint32_t>(hash<string>()(kunci)); }
+
+    // Sizes the table for n entries at most 3/4 full
+    void reserve(size_t n) {
+        size_t kapasitas = 16;
+        while (kapasitas * 3 < n * 4) kapasitas *= 2;
+        if (kapasitas > tabel.size()) ubahKapasitas(kapasitas);
+    }
+
+    // Slot whose key equals `kunci`, or NOT_FOUND; kunciSlot(slot) returns the key stored for a slot
+    template <typename KunciSlot>
+    size_t cari(const string& kunci, uint32_t h, KunciSlot kunciSlot) const {
+        if (tabel.empty()) return NOT_FOUND;
+        size_t mask = tabel.size() - 1;
+        for (size_t i = h & mask; tabel[i] != 0; i = (i + 1) & mask) {
+            if (static_cast<uint32_t>(tabel[i] >> 32) == h) {
+                size_t slot = static_cast<uint32_t>(tabel[i]) - 1;
+                if (kunciSlot(slot) == kunci) return slot;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    // Adds a slot whose key is not in the index yet
+    void tambah(size_t slot, uint32_t h) {
+        if ((jumlah + 1) * 4 > tabel.size() * 3) ubahKapasitas(max<size_t>(16, tabel.size() * 2));
+        taruh((uint64_t(h) << 32) | uint64_t(slot + 1));
+        jumlah++;
+    }
+};
+
+// 5. Book Catalog - Slot storage with secondary indexes (title tree + hash indexes)
+// Every book lives in one slot of `buku`; the indexes only store slot numbers, so they stay
+// consistent as long as a book is never moved (books are only appended, never erased).
+//   - indeksJudul : hash index on title, keeps titles unique (title order comes from indeksDosen
+//                   and sortByJudul, as the old std::set<Buku> ordering did)
+//   - indeksId    : hash index on book ID, O(1) lookup for borrowBook
+//   - indeksDosen : per-mentor posting list of slots, kept sorted by title
+//   - indeksTrigram : inverted index from each 3-byte substring of the lowercased title to the
+//                     slots containing it, so searches only verify candidate postings
+// Lowercased titles are stored back to back in one byte arena (judulArena, '\0'-separated) so the
+// SIMD substring kernel can scan them without per-title allocations.
+// Loan state is kept apart from the books themselves in a bitmap indexed by slot, so borrowing
+// is a single bit flip and never touches the title tree or copies strings.
+// Thread safety: the catalog is built before it is shared; afterwards only availability changes,
+// through atomic operations on the bitmap words, so concurrent borrowers need no lock and two
+// students can never both take the same book.
+class KatalogBuku {
+private:
+    vector<Buku> buku;
+    deque<atomic<uint64_t>> tersediaBits; // Bit (slot % 64) of word (slot / 64) is set if the book is available
+    IndeksSlot indeksJudul;
+    IndeksSlot indeksId;
+    unordered_map<string, vector<size_t>> indeksDosen;
+    vector<size_t> kosong; // Returned for mentors without books
+    string judulArena;             // Lowercased titles, computed once on insert
+    vector<size_t> judulAwal;      // Start of each slot's title in judulArena (plus one past the end)
+    unordered_map<uint32_t, vector<uint32_t>> indeksTrigram; // Postings are ascending slot numbers
+    SubstringKernel kernel;
+
+    size_t slotDenganJudul(const string& judul, uint32_t h) const {
+        return indeksJudul.cari(judul, h, [this](size_t s) -> const string& { return buku[s].judul; });
+    }
+    size_t slotDenganId(const string& id, uint32_t h) const {
+        return indeksId.cari(id, h, [this](size_t s) -> const string& { return buku[s].id; });
+    }
+
+    const char* judulLower(size_t slot) const { return judulArena.data() + judulAwal[slot]; }
+    size_t panjangJudul(size_t slot) const { return judulAwal[slot + 1] - judulAwal[slot] - 1; }
+
+    bool judulMengandung(size_t slot, const string& keywordLower) const {
+        return kernel(judulLower(slot), panjangJudul(slot), keywordLower.data(), keywordLower.size()) != NOT_FOUND_POS;
+    }
+
+    static uint32_t trigramKey(const char* p) {
+        return uint32_t(uint8_t(p[0])) | (uint32_t(uint8_t(p[1])) << 8) | (uint32_t(uint8_t(p[2])) << 16);
+    }
+
+    void indexTrigrams(size_t slot) {
+        const char* judul = judulLower(slot);
+        for (size_t i = 0; i + 3 <= panjangJudul(slot); i++) {
+            vector<uint32_t>& posting = indeksTrigram[trigramKey(judul + i)];
+            if (posting.empty() || posting.back() != slot) { // A title can repeat a trigram
+                posting.push_back(static_cast<uint32_t>(slot));
+            }
+        }
+    }
+
+    // Bulk trigram build over every slot: counts each key's postings first so every list is
+    // allocated once at its final size, then fills the lists in slot order. Keys are 24-bit, so
+    // the counts live in flat arrays instead of a hash map, and each thread owns the keys whose
+    // hash selects it, so no two threads ever touch the same list.
+    void bangunTrigramMassal() {
+        const size_t JUMLAH_KUNCI = size_t(1) << 24;
+        const uint32_t BELUM = static_cast<uint32_t>(-1);
+        size_t n = buku.size();
+        vector<uint32_t> jumlah(JUMLAH_KUNCI, 0);
+        vector<uint32_t> terakhir(JUMLAH_KUNCI, BELUM); // Last slot seen per key (a title can repeat a trigram)
+        vector<uint32_t*> kursor; // Write position in each non-empty list
+        size_t jumlahThread = 1; // Power of two, so a key's owner is a mask of its hash
+        while (jumlahThread * 2 <= thread::hardware_concurrency()) jumlahThread *= 2;
+
+        auto lintasan = [&](bool isi) {
+            vector<thread> threads;
+            for (size_t t = 0; t < jumlahThread; t++) {
+                threads.emplace_back([&, t, isi]() {
+                    for (size_t slot = 0; slot < n; slot++) {
+                        const char* judul = judulLower(slot);
+                        size_t panjang = panjangJudul(slot);
+                        for (size_t i = 0; i + 3 <= panjang; i++) {
+                            uint32_t kunci = trigramKey(judul + i);
+                            if (((kunci * 2654435761u) >> 24 & (jumlahThread - 1)) != t || terakhir[kunci] == slot) continue;
+                            terakhir[kunci] = static_cast<uint32_t>(slot);
+                            if (isi) {
+                                *kursor[jumlah[kunci]]++ = static_cast<uint32_t>(slot);
+                            } else {
+                                jumlah[kunci]++;
+                            }
+                        }
+                    }
+                });
+            }
+            for (thread& th : threads) th.join();
+        };
+
+        lintasan(false);
+        for (size_t kunci = 0; kunci < JUMLAH_KUNCI; kunci++) {
+            if (jumlah[kunci] == 0) continue;
+            vector<uint32_t>& posting = indeksTrigram[static_cast<uint32_t>(kunci)];
+            posting.resize(jumlah[kunci]);
+            jumlah[kunci] = static_cast<uint32_t>(kursor.size()); // From now on: index into kursor
+            kursor.push_back(posting.data());
+        }
+        fill(terakhir.begin(), terakhir.end(), BELUM);
+        lintasan(true);
+    }
+
+    struct KunciJudul {
+        uint64_t awalan[4]; // 32 title bytes from the current offset, big-endian, zero-padded
+        uint32_t slot;      // 32-bit like the trigram postings
+    };
+
+    void isiKunciJudul(KunciJudul& k, size_t offset) const {
+        const string& judul = buku[k.slot].judul;
+        for (size_t w = 0; w < 4; w++) {
+            uint64_t awalan = 0;
+            for (size_t i = offset + w * 8; i < offset + w * 8 + 8; i++) {
+                awalan = (awalan << 8) | (i < judul.size() ? static_cast<uint8_t>(judul[i]) : 0);
+            }
+            k.awalan[w] = awalan;
+        }
+    }
+
+    static bool awalanLebihKecil(const KunciJudul& a, const KunciJudul& b) {
+        for (size_t w = 0; w < 3; w++) {
+            if (a.awalan[w] != b.awalan[w]) return a.awalan[w] < b.awalan[w];
+        }
+        return a.awalan[3] < b.awalan[3];
+    }
+
+    // Sorts kunci[awal, akhir) by title, given keys holding the 32 bytes at `offset`: sorts on the
+    // keys, then refines each run of equal keys with the next 32 bytes. Every title is read once
+    // per level instead of once per comparison.
+    void urutkanJudul(vector<KunciJudul>& kunci, size_t awal, size_t akhir, size_t offset) const {
+        sort(kunci.begin() + awal, kunci.begin() + akhir, awalanLebihKecil);
+        for (size_t i = awal; i < akhir;) {
+            size_t j = i + 1;
+            while (j < akhir && !awalanLebihKecil(kunci[i], kunci[j])) j++;
+            bool lanjut = false;
+            for (size_t e = i; e < j && j - i > 1 && !lanjut; e++) {
+                lanjut = buku[kunci[e].slot].judul.size() > offset + 32;
+            }
+            if (lanjut) {
+                for (size_t e = i; e < j; e++) isiKunciJudul(kunci[e], offset + 32);
+                urutkanJudul(kunci, i, j, offset + 32);
+            } else if (j - i > 1) { // Only titles that differ in embedded NULs get here
+                sort(kunci.begin() + i, kunci.begin() + j, [this](const KunciJudul& a, const KunciJudul& b) {
+                    return buku[a.slot].judul < buku[b.slot].judul;
+                });
+            }
+            i = j;
+        }
+    }
+
+    // Mentor posting lists for a bulk build. Slots are bucketed by mentor (a counting sort in slot
+    // order, so titles are read sequentially to fill the first keys), then each bucket is sorted by
+    // title on its own: buckets are independent, sorted in parallel and never merged.
+    void bangunPostingDosen() {
+        size_t k = buku.size();
+        vector<const string*> nama; // Mentor names in first-seen order
+        unordered_map<string, uint32_t> idNama;
+        vector<uint32_t> idDosen(k);
+        for (size_t slot = 0; slot < k; slot++) {
+            const string& dosen = buku[slot].dosen_referensi;
+            if (slot > 0 && dosen == buku[slot - 1].dosen_referensi) {
+                idDosen[slot] = idDosen[slot - 1];
+                continue;
+            }
+            auto it = idNama.find(dosen);
+            if (it == idNama.end()) {
+                it = idNama.emplace(dosen, static_cast<uint32_t>(nama.size())).first;
+                nama.push_back(&dosen);
+            }
+            idDosen[slot] = it->second;
+        }
+
+        size_t m = nama.size();
+        vector<vector<size_t>> jumlahPerThread(max<size_t>(1, thread::hardware_concurrency()), vector<size_t>(m, 0));
+        size_t jumlahThread = jalankanParalel(k, [&](size_t awal, size_t akhir, size_t t) {
+            for (size_t slot = awal; slot < akhir; slot++) jumlahPerThread[t][idDosen[slot]]++;
+        });
+        vector<size_t> awalBucket(m + 1, 0);
+        for (size_t d = 0; d < m; d++) {
+            size_t posisi = awalBucket[d];
+            for (size_t t = 0; t < jumlahThread; t++) { // Counts become each thread's write cursor
+                size_t jumlah = jumlahPerThread[t][d];
+                jumlahPerThread[t][d] = posisi;
+                posisi += jumlah;
+            }
+            awalBucket[d + 1] = posisi;
+        }
+        vector<KunciJudul> kunci(k);
+        jalankanParalel(k, [&](size_t awal, size_t akhir, size_t t) {
+            for (size_t slot = awal; slot < akhir; slot++) {
+                KunciJudul& tujuan = kunci[jumlahPerThread[t][idDosen[slot]]++];
+                tujuan.slot = static_cast<uint32_t>(slot);
+                isiKunciJudul(tujuan, 0);
+            }
+        });
+        jalankanParalel(k, [&](size_t awal, size_t akhir, size_t) { // A bucket goes to the thread holding its start
+            size_t d = lower_bound(awalBucket.begin(), awalBucket.end() - 1, awal) - awalBucket.begin();
+            for (; d < m && awalBucket[d] < akhir; d++) urutkanJudul(kunci, awalBucket[d], awalBucket[d + 1], 0);
+        });
+
+        for (size_t d = 0; d < m; d++) {
+            vector<size_t>& posting = indeksDosen[*nama[d]];
+            posting.reserve(awalBucket[d + 1] - awalBucket[d]);
+            for (size_t e = awalBucket[d]; e < awalBucket[d + 1]; e++) posting.push_back(kunci[e].slot);
+        }
+    }
+
+public:
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    KatalogBuku() : judulAwal(1, 0), kernel(selectSubstringKernel()) {}
+
+    // Overrides the runtime-selected kernel (used by benchmarks to compare implementations)
+    void setKernel(SubstringKernel k) { kernel = k; }
+
+    // ::tolower of every byte value, looked up instead of called per character
+    static const char* tabelHurufKecil() {
+        static const string tabel = [] {
+            string t(256, '\0');
+            for (int c = 0; c < 256; c++) t[c] = static_cast<char>(::tolower(c));
+            return t;
+        }();
+        return tabel.data();
+    }
+
+    // Same lowercasing searchBooks has always used (byte-wise ::tolower)
+    static string toLowerCopy(const string& text) {
+        const char* tabel = tabelHurufKecil();
+        string lower = text;
+        for (char& c : lower) c = tabel[static_cast<uint8_t>(c)];
+        return lower;
+    }
+
+    // Returns false (and changes nothing) if the title or ID already exists, like std::set::insert
+    bool insert(const Buku& b, bool tersedia = true) {
+        uint32_t hJudul = IndeksSlot::hashKunci(b.judul);
+        uint32_t hId = IndeksSlot::hashKunci(b.id);
+        if (slotDenganJudul(b.judul, hJudul) != NOT_FOUND || slotDenganId(b.id, hId) != NOT_FOUND) {
+            return false;
+        }
+        size_t slot = buku.size();
+        buku.push_back(b);
+        if (slot % 64 == 0) {
+            tersediaBits.emplace_back(0);
+        }
+        setTersedia(slot, tersedia);
+        indeksJudul.tambah(slot, hJudul);
+        indeksId.tambah(slot, hId);
+
+        vector<size_t>& posting = indeksDosen[b.dosen_referensi];
+        auto pos = lower_bound(posting.begin(), posting.end(), b.judul,
+                               [this](size_t s, const string& judul) { return buku[s].judul < judul; });
+        posting.insert(pos, slot);
+
+        judulArena += toLowerCopy(b.judul);
+        judulArena += '\0';
+        judulAwal.push_back(judulArena.size());
+        indexTrigrams(slot);
+        return true;
+    }
+
+    size_t findSlotById(const string& id) const {
+        return slotDenganId(id, IndeksSlot::hashKunci(id));
+    }
+
+    // Slots of all books referenced by a mentor, in title order
+    const vector<size_t>& slotsByDosen(const string& dosen) const {
+        auto it = indeksDosen.find(dosen);
+        return it == indeksDosen.end() ? kosong : it->second;
+    }
+
+    // Scans the whole title arena with the substring kernel and returns every matching slot in
+    // ascending order. Each hit is mapped back to its slot; a hit that straddles two titles is
+    // skipped, and after a real match the scan resumes at the next title.
+    vector<size_t> scanJudul(const string& keywordLower) const {
+        vector<size_t> hasil;
+        const char* data = judulArena.data();
+        size_t n = judulArena.size();
+        size_t pos = 0;
+        size_t slot = 0; // Hits only move forward, so the owning slot is found by advancing a cursor
+        while (pos < n) {
+            size_t hit = kernel(data + pos, n - pos, keywordLower.data(), keywordLower.size());
+            if (hit == NOT_FOUND_POS) break;
+            hit += pos;
+            while (judulAwal[slot + 1] <= hit) slot++;
+            if (hit + keywordLower.size() <= judulAwal[slot] + panjangJudul(slot)) {
+                hasil.push_back(slot);
+                pos = judulAwal[slot + 1];
+            } else {
+                pos = hit + 1;
+            }
+        }
+        return hasil;
+    }
+
+    // Case-insensitive substring search within a mentor's books, returning matching slots.
+    // Keywords of 3+ bytes only verify the postings of their rarest trigram (or the mentor's
+    // posting list if that is shorter). Shorter keywords fall back to a scan: one arena-wide
+    // kernel pass when the mentor owns a large share of the catalog, otherwise the kernel runs
+    // on each of the mentor's titles.
+    vector<size_t> cariJudul(const string& keyword, const string& dosen) const {
+        string keywordLower = toLowerCopy(keyword);
+        const vector<size_t>& postingDosen = slotsByDosen(dosen);
+        const vector<uint32_t>* kandidat = nullptr;
+
+        for (size_t i = 0; i + 3 <= keywordLower.size(); i++) {
+            auto it = indeksTrigram.find(trigramKey(keywordLower.data() + i));
+            if (it == indeksTrigram.end()) {
+                return {}; // No title contains this trigram, so none can contain the keyword
+            }
+            if (kandidat == nullptr || it->second.size() < kandidat->size()) {
+                kandidat = &it->second;
+            }
+        }
+
+        vector<size_t> hasil;
+        if (kandidat != nullptr && kandidat->size() < postingDosen.size()) {
+            for (uint32_t slot : *kandidat) {
+                if (buku[slot].dosen_referensi == dosen && judulMengandung(slot, keywordLower)) {
+                    hasil.push_back(slot);
+                }
+            }
+        } else if (kandidat == nullptr && !keywordLower.empty() && postingDosen.size() * 4 >= buku.size()) {
+            for (size_t slot : scanJudul(keywordLower)) {
+                if (buku[slot].dosen_referensi == dosen) {
+                    hasil.push_back(slot);
+                }
+            }
+        } else {
+            for (size_t slot : postingDosen) {
+                if (judulMengandung(slot, keywordLower)) {
+                    hasil.push_back(slot);
+                }
+            }
+        }
+        return hasil;
+    }
+
+    // Bulk build (CSV import, snapshot load). Same result as calling insert() for each book in
+    // order (first title/ID wins, slots follow the input), but every index is built in one pass:
+    // hashes, lowercased titles and trigram postings are computed in parallel, and the mentor
+    // posting lists come from per-mentor title sorts. `tersedia` gives each book's
+    // availability (empty: all available). Only an empty catalog is bulk-built; otherwise the
+    // books go through insert(). Returns the number of books added.
+    size_t muatMassal(vector<Buku> daftar, const vector<bool>& tersedia = vector<bool>()) {
+        size_t n = daftar.size();
+        if (!buku.empty()) {
+            size_t ditambah = 0;
+            for (size_t i = 0; i < n; i++) {
+                ditambah += insert(daftar[i], tersedia.empty() || tersedia[i]);
+            }
+            return ditambah;
+        }
+
+        vector<uint32_t> hJudul(n), hId(n);
+        jalankanParalel(n, [&](size_t awal, size_t akhir, size_t) {
+            for (size_t i = awal; i < akhir; i++) {
+                hJudul[i] = IndeksSlot::hashKunci(daftar[i].judul);
+                hId[i] = IndeksSlot::hashKunci(daftar[i].id);
+            }
+        });
+
+        // Drop repeated titles/IDs and compact in place; the indexes only read slots below k
+        buku = std::move(daftar);
+        indeksJudul.reserve(n);
+        indeksId.reserve(n);
+        size_t k = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (slotDenganJudul(buku[i].judul, hJudul[i]) != NOT_FOUND || slotDenganId(buku[i].id, hId[i]) != NOT_FOUND) {
+                continue;
+            }
+            if (k != i) buku[k] = std::move(buku[i]);
+            indeksJudul.tambah(k, hJudul[i]);
+            indeksId.tambah(k, hId[i]);
+            if (k % 64 == 0) {
+                tersediaBits.emplace_back(0);
+            }
+            setTersedia(k, tersedia.empty() || tersedia[i]);
+            k++;
+        }
+        buku.resize(k);
+
+        for (size_t slot = 0; slot < k; slot++) {
+            judulAwal.push_back(judulAwal.back() + buku[slot].judul.size() + 1);
+        }
+        judulArena.assign(judulAwal.back(), '\0');
+        jalankanParalel(k, [this](size_t awal, size_t akhir, size_t) {
+            const char* tabel = tabelHurufKecil();
+            for (size_t slot = awal; slot < akhir; slot++) {
+                char* tujuan = &judulArena[judulAwal[slot]];
+                for (char c : buku[slot].judul) *tujuan++ = tabel[static_cast<uint8_t>(c)];
+            }
+        });
+        if (k < (size_t(1) << 16)) { // Too few titles to pay for the flat key arrays
+            for (size_t slot = 0; slot < k; slot++) indexTrigrams(slot);
+        } else {
+            bangunTrigramMassal();
+        }
+
+        bangunPostingDosen();
+        return k;
+    }
+
+    // Orders slots by title, matching the catalog's title order
+    void sortByJudul(vector<size_t>& slots) const {
+        sort(slots.begin(), slots.end(), [this](size_t a, size_t b) { return buku[a].judul < buku[b].judul; });
+    }
+
+    const Buku& at(size_t slot) const { return buku[slot]; }
+
+    bool isTersedia(size_t slot) const {
+        return (tersediaBits[slot / 64].load(memory_order_acquire) >> (slot % 64)) & 1;
+    }
+
+    void setTersedia(size_t slot, bool tersedia) {
+        uint64_t mask = uint64_t(1) << (slot % 64);
+        if (tersedia) {
+            tersediaBits[slot / 64].fetch_or(mask, memory_order_acq_rel);
+        } else {
+            tersediaBits[slot / 64].fetch_and(~mask, memory_order_acq_rel);
+        }
+    }
+
+    // Marks the book as borrowed; returns false if it was already borrowed.
+    // Compare-and-swap on the bitmap word: only the caller that clears the bit wins.
+    bool pinjam(size_t slot) {
+        atomic<uint64_t>& word = tersediaBits[slot / 64];
+        uint64_t mask = uint64_t(1) << (slot % 64);
+        uint64_t lama = word.load(memory_order_relaxed);
+        while (lama & mask) {
+            if (word.compare_exchange_weak(lama, lama & ~mask, memory_order_acq_rel, memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t size() const { return buku.size(); }
+    bool empty() const { return buku.empty(); }
+};
+
+// Co-borrow Recommendations - "Students who borrowed this also borrowed". Every book that has been
+// borrowed together with another has a sparse row counting, per other book, how many students
+// borrowed both (a new loan is paired with the student's last JENDELA distinct loans). Each row
+// also keeps its TOP_K highest counts in order, fixed up on every increment: counts only grow, so
+// a book outside the list can only enter by passing the list's last entry. A loan therefore costs
+// O(JENDELA * TOP_K) and a query O(TOP_K), however large the catalog is.
+// Rows are open-addressed (slot, count) tables, split by slot into independently locked shards.
+class RekomendasiBuku {
+public:
+    static const size_t JENDELA = 16;
+    static const size_t TOP_K = 10;
+
+    struct Skor {
+        uint32_t slot;
+        uint32_t jumlah; // Students who borrowed both books
+    };
+
+private:
+    static const uint32_t KOSONG = static_cast<uint32_t>(-1);
+
+    struct Baris {
+        vector<Skor> sel; // Open addressing, capacity a power of two; slot KOSONG = free cell
+        uint32_t isi = 0;
+        uint32_t jumlahTop = 0;
+        Skor top[TOP_K]; // Highest counts first; inline so an update touches one less cache line
+
+        void tambah(uint32_t slot, uint32_t n) {
+            if ((isi + 1) * 4 > sel.size() * 3) tumbuh();
+            size_t mask = sel.size() - 1;
+            size_t i = (slot * 0x9E3779B1u) & mask;
+            while (sel[i].slot != slot && sel[i].slot != KOSONG) i = (i + 1) & mask;
+            if (sel[i].slot == KOSONG) {
+                sel[i] = {slot, 0};
+                isi++;
+            }
+            sel[i].jumlah += n;
+            perbaruiTop(slot, sel[i].jumlah);
+        }
+
+        void tumbuh() {
+            vector<Skor> lama(max<size_t>(sel.size() * 2, 4), Skor{KOSONG, 0});
+            lama.swap(sel);
+            size_t mask = sel.size() - 1;
+            for (const Skor& s : lama) {
+                if (s.slot == KOSONG) continue;
+                size_t i = (s.slot * 0x9E3779B1u) & mask;
+                while (sel[i].slot != KOSONG) i = (i + 1) & mask;
+                sel[i] = s;
+            }
+        }
+
+        void perbaruiTop(uint32_t slot, uint32_t jumlah) {
+            size_t i = 0;
+            while (i < jumlahTop && top[i].slot != slot) i++;
+            if (i < jumlahTop) {
+                top[i].jumlah = jumlah;
+            } else if (jumlahTop < TOP_K) {
+                top[jumlahTop++] = {slot, jumlah};
+            } else if (jumlah > top[TOP_K - 1].jumlah) {
+                top[TOP_K - 1] = {slot, jumlah};
+                i = TOP_K - 1;
+            } else {
+                return;
+            }
+            for (; i > 0 && top[i - 1].jumlah < top[i].jumlah; i--) swap(top[i - 1], top[i]);
+        }
+    };
+
+    struct ShardBaris {
+        mutable mutex kunci;
+        unordered_map<uint32_t, Baris> baris; // Book slot -> its row
+    };
+    static const size_t JUMLAH_SHARD = 64;
+
+    ShardBaris shard[JUMLAH_SHARD];
+
+    ShardBaris& shardUntuk(uint32_t slot) { return shard[slot % JUMLAH_SHARD]; }
+    const ShardBaris& shardUntuk(uint32_t slot) const { return shard[slot % JUMLAH_SHARD]; }
+
+public:
+    // Moves slot to the newest end of a student's window of recent loans (oldest first), dropping
+    // the oldest beyond JENDELA. Returns false if the book was already in the window.
+    static bool geserJendela(vector<uint32_t>& jendela, uint32_t slot) {
+        auto it = find(jendela.begin(), jendela.end(), slot);
+        bool baru = it == jendela.end();
+        if (!baru) jendela.erase(it);
+        else if (jendela.size() >= JENDELA) jendela.erase(jendela.begin());
+        jendela.push_back(slot);
+        return baru;
+    }
+
+    // Counts a new loan of `slot` once against each book in `sebelumnya` (the student's window
+    // before this loan)
+    void catat(uint32_t slot, const vector<uint32_t>& sebelumnya) {
+        if (sebelumnya.empty()) return;
+        {
+            ShardBaris& s = shardUntuk(slot);
+            lock_guard<mutex> lock(s.kunci);
+            Baris& baris = s.baris[slot];
+            for (uint32_t lain : sebelumnya) {
+                if (lain != slot) baris.tambah(lain, 1);
+            }
+        }
+        for (uint32_t lain : sebelumnya) {
+            if (lain == slot) continue;
+            ShardBaris& s = shardUntuk(lain);
+            lock_guard<mutex> lock(s.kunci);
+            s.baris[lain].tambah(slot, 1);
+        }
+    }
+
+    // Up to k books most often borrowed together with `slot`, highest count first (k <= TOP_K)
+    vector<Skor> teratas(uint32_t slot, size_t k = TOP_K) const {
+        const ShardBaris& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.baris.find(slot);
+        if (it == s.baris.end()) return {};
+        const Baris& baris = it->second;
+        return vector<Skor>(baris.top, baris.top + min<size_t>(k, baris.jumlahTop));
+    }
+
+    // Reference: the same top k computed by scanning the whole row
+    vector<Skor> teratasScan(uint32_t slot, size_t k = TOP_K) const {
+        const ShardBaris& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.baris.find(slot);
+        if (it == s.baris.end()) return {};
+        vector<Skor> semua;
+        for (const Skor& sel : it->second.sel) {
+            if (sel.slot != KOSONG) semua.push_back(sel);
+        }
+        k = min(k, semua.size());
+        partial_sort(semua.begin(), semua.begin() + k, semua.end(),
+                     [](const Skor& a, const Skor& b) { return a.jumlah > b.jumlah; });
+        semua.resize(k);
+        return semua;
+    }
+
+    // Restores one row saved by untukSetiapBaris()
+    void muatBaris(uint32_t slot, const vector<Skor>& isiBaris) {
+        ShardBaris& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        Baris& baris = s.baris[slot];
+        for (const Skor& sel : isiBaris) baris.tambah(sel.slot, sel.jumlah);
+    }
+
+    // Calls f(slot, counts) for every row; no other call may run meanwhile
+    template <typename F>
+    void untukSetiapBaris(F f) const {
+        vector<Skor> isiBaris;
+        for (const ShardBaris& s : shard) {
+            for (const auto& entry : s.baris) {
+                isiBaris.clear();
+                for (const Skor& sel : entry.second.sel) {
+                    if (sel.slot != KOSONG) isiBaris.push_back(sel);
+                }
+                f(entry.first, isiBaris);
+            }
+        }
+    }
+
+    // Rows and nonzero counts, for sizing
+    size_t jumlahBaris() const {
+        size_t n = 0;
+        for (const ShardBaris& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            n += s.baris.size();
+        }
+        return n;
+    }
+    size_t jumlahPasangan() const {
+        size_t n = 0;
+        for (const ShardBaris& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            for (const auto& entry : s.baris) n += entry.second.isi;
+        }
+        return n;
+    }
+};
+
+// Campus Road Graph - Streets and places as nodes, two-way road segments as weighted edges (meters).
+// bangunIndeks() packs the segments into CSR arrays and precomputes a contraction hierarchy: nodes
+// are contracted from least to most important, adding a shortcut wherever a contraction would
+// break a shortest path, so a query is two upward searches (from the start and from the target)
+// that meet at the highest node of the route. A route is unpacked by expanding every shortcut
+// into the two arcs through the node it bypasses. cariJalurDijkstra() is the plain search over
+// the original segments, kept as the reference. Routes to campus do not search at all: every node
+// keeps its next step on a shortest-path tree rooted at the campus buildings, also built by
+// bangunIndeks(). Queries may run on many threads at once.
+class GrafJalan {
+public:
+    static const uint32_t TIDAK_ADA = static_cast<uint32_t>(-1);
+    static const uint32_t TAK_HINGGA = static_cast<uint32_t>(-1);
+    // Most meters of road one graph may hold. Every distance is a sum over distinct segments, so
+    // it stays below this, and the sum of two (a meeting or a stall test) below TAK_HINGGA.
+    static const uint64_t BATAS_PANJANG = TAK_HINGGA / 2;
+
+private:
+    struct Busur {
+        uint32_t ke;
+        uint32_t bobot;  // Meters
+        uint32_t tengah; // Node a shortcut bypasses, TIDAK_ADA for a real segment
+    };
+    struct Ruas {
+        uint32_t a, b, meter;
+    };
+
+    // Per-thread search state, sized to the largest graph searched; every entry is TAK_HINGGA
+    // between queries (only the touched nodes are reset)
+    struct RuangCari {
+        vector<uint32_t> jarak[2];
+        vector<uint32_t> induk[2];
+        vector<uint32_t> disentuh;
+        vector<pair<uint32_t, uint32_t>> antrian[2]; // Min-heaps of (distance, node)
+
+        void siapkan(size_t n) {
+            for (int arah = 0; arah < 2; arah++) {
+                if (jarak[arah].size() < n) {
+                    jarak[arah].resize(n, TAK_HINGGA);
+                    induk[arah].resize(n, TIDAK_ADA);
+                }
+                antrian[arah].clear();
+            }
+        }
+        void bersihkan() {
+            for (uint32_t v : disentuh) jarak[0][v] = jarak[1][v] = TAK_HINGGA;
+            disentuh.clear();
+        }
+        void dorong(int arah, uint32_t d, uint32_t v) {
+            antrian[arah].push_back({d, v});
+            push_heap(antrian[arah].begin(), antrian[arah].end(), greater<pair<uint32_t, uint32_t>>());
+        }
+        pair<uint32_t, uint32_t> ambil(int arah) {
+            pop_heap(antrian[arah].begin(), antrian[arah].end(), greater<pair<uint32_t, uint32_t>>());
+            pair<uint32_t, uint32_t> atas = antrian[arah].back();
+            antrian[arah].pop_back();
+            return atas;
+        }
+    };
+
+    vector<string> nama;                      // Node ID -> street or place name
+    unordered_map<string, uint32_t> idNama;   // Names and aliases -> node ID
+    vector<Ruas> ruas;                        // Segments as loaded
+    uint64_t panjang = 0;                     // Their total length in meters
+    vector<pair<string, uint32_t>> stasiun;   // Stations offered as start points, in load order
+    vector<uint32_t> kampus;                  // Campus buildings (route destinations)
+
+    vector<uint32_t> awalTetangga; // CSR of the segments in both directions (n + 1 offsets)
+    vector<Busur> tetangga;
+    vector<uint32_t> peringkat;    // Contraction order: higher = more important
+    vector<uint32_t> awalNaik;     // CSR of the arcs to higher-ranked nodes (segments and shortcuts)
+    vector<Busur> naik;
+    vector<uint32_t> menujuKampus; // Next node toward the nearest campus building (TIDAK_ADA at one)
+    vector<uint32_t> jarakKampus;  // Meters to that building (TAK_HINGGA if none can be reached)
+
+    static RuangCari& ruang() {
+        thread_local RuangCari r;
+        return r;
+    }
+
+    // Adds a->b or shortens an existing a->b arc
+    static void sambung(vector<Busur>& daftar, uint32_t b, uint32_t bobot, uint32_t tengah) {
+        for (Busur& busur : daftar) {
+            if (busur.ke == b) {
+                if (bobot < busur.bobot) busur = {b, bobot, tengah};
+                return;
+            }
+        }
+        daftar.push_back({b, bobot, tengah});
+    }
+
+    // Appends the nodes after a on the original road a -> b (a itself is already in the path)
+    void bukaBusur(uint32_t a, uint32_t b, vector<uint32_t>& jalur) const {
+        uint32_t bawah = peringkat[a] < peringkat[b] ? a : b; // An arc is stored at its lower end
+        uint32_t atas = bawah == a ? b : a;
+        for (uint32_t i = awalNaik[bawah]; i < awalNaik[bawah + 1]; i++) {
+            if (naik[i].ke != atas) continue;
+            if (naik[i].tengah == TIDAK_ADA) {
+                jalur.push_back(b);
+            } else {
+                bukaBusur(a, naik[i].tengah, jalur);
+                bukaBusur(naik[i].tengah, b, jalur);
+            }
+            return;
+        }
+    }
+
+    void kontraksi();
+
+    // Reverse shortest-path trees rooted at every campus building, grown together by one Dijkstra
+    // over the segments (which are two-way, so a tree toward a root is also a tree from it)
+    void bangunPohonKampus() {
+        size_t n = nama.size();
+        menujuKampus.assign(n, TIDAK_ADA);
+        jarakKampus.assign(n, TAK_HINGGA);
+        vector<pair<uint32_t, uint32_t>> antrian; // Min-heap of (distance, node)
+        greater<pair<uint32_t, uint32_t>> lebihJauh;
+        for (uint32_t k : kampus) {
+            jarakKampus[k] = 0;
+            antrian.push_back({0, k});
+        }
+        make_heap(antrian.begin(), antrian.end(), lebihJauh);
+        while (!antrian.empty()) {
+            pop_heap(antrian.begin(), antrian.end(), lebihJauh);
+            pair<uint32_t, uint32_t> atas = antrian.back();
+            antrian.pop_back();
+            uint32_t d = atas.first, v = atas.second;
+            if (d > jarakKampus[v]) continue;
+            for (uint32_t i = awalTetangga[v]; i < awalTetangga[v + 1]; i++) {
+                const Busur& busur = tetangga[i];
+                uint32_t baru = d + busur.bobot;
+                if (baru < jarakKampus[busur.ke]) {
+                    jarakKampus[busur.ke] = baru;
+                    menujuKampus[busur.ke] = v;
+                    antrian.push_back({baru, busur.ke});
+                    push_heap(antrian.begin(), antrian.end(), lebihJauh);
+                }
+            }
+        }
+    }
+
+public:
+    uint32_t tambahTitik(const string& namaTitik) {
+        auto it = idNama.find(namaTitik);
+        if (it != idNama.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(nama.size());
+        nama.push_back(namaTitik);
+        idNama.emplace(namaTitik, id);
+        return id;
+    }
+
+    // Another name for a node (a station's short name); false if the name is taken
+    bool tambahAlias(const string& alias, uint32_t id) {
+        return idNama.emplace(alias, id).second;
+    }
+
+    uint32_t cariTitik(const string& namaTitik) const {
+        auto it = idNama.find(namaTitik);
+        return it == idNama.end() ? TIDAK_ADA : it->second;
+    }
+
+    void tambahJalan(uint32_t a, uint32_t b, uint32_t meter) {
+        ruas.push_back({a, b, meter});
+        panjang += meter;
+    }
+
+    void tambahStasiun(const string& label, uint32_t id) {
+        stasiun.push_back({label, id});
+    }
+
+    void tandaiKampus(uint32_t id) {
+        if (find(kampus.begin(), kampus.end(), id) == kampus.end()) kampus.push_back(id);
+    }
+
+    const string& namaTitik(uint32_t id) const { return nama[id]; }
+    const vector<pair<string, uint32_t>>& daftarStasiun() const { return stasiun; }
+    const vector<uint32_t>& daftarKampus() const { return kampus; }
+    size_t jumlahTitik() const { return nama.size(); }
+    size_t jumlahBusur() const { return tetangga.size(); }
+    size_t jumlahBusurNaik() const { return naik.size(); }
+    uint64_t panjangTotal() const { return panjang; }
+
+    // Length of the shortest segment a-b (TAK_HINGGA if they are not adjacent)
+    uint32_t panjangRuas(uint32_t a, uint32_t b) const {
+        uint32_t terpendek = TAK_HINGGA;
+        for (uint32_t i = awalTetangga[a]; i < awalTetangga[a + 1]; i++) {
+            if (tetangga[i].ke == b) terpendek = min(terpendek, tetangga[i].bobot);
+        }
+        return terpendek;
+    }
+
+    // Builds the CSR arrays and the hierarchy; call again after adding nodes or segments
+    void bangunIndeks() {
+        size_t n = nama.size();
+        vector<uint32_t> derajat(n + 1, 0);
+        for (const Ruas& r : ruas) {
+            if (r.a == r.b) continue;
+            derajat[r.a]++;
+            derajat[r.b]++;
+        }
+        awalTetangga.assign(n + 1, 0);
+        for (size_t v = 0; v < n; v++) awalTetangga[v + 1] = awalTetangga[v] + derajat[v];
+        tetangga.resize(awalTetangga[n]);
+        vector<uint32_t> posisi(awalTetangga.begin(), awalTetangga.end() - 1);
+        for (const Ruas& r : ruas) {
+            if (r.a == r.b) continue;
+            tetangga[posisi[r.a]++] = {r.b, r.meter, TIDAK_ADA};
+            tetangga[posisi[r.b]++] = {r.a, r.meter, TIDAK_ADA};
+        }
+        kontraksi();
+        bangunPohonKampus();
+    }
+
+    // Shortest route from s to the nearest campus building, read off the trees in O(route length);
+    // same contract as cariJalur()
+    uint32_t cariJalurKampus(uint32_t s, vector<uint32_t>* jalur = nullptr) const {
+        if (jalur != nullptr) jalur->clear();
+        if (s >= jarakKampus.size() || jarakKampus[s] == TAK_HINGGA) return TAK_HINGGA;
+        if (jalur != nullptr) {
+            for (uint32_t v = s; v != TIDAK_ADA; v = menujuKampus[v]) jalur->push_back(v);
+        }
+        return jarakKampus[s];
+    }
+
+    // Shortest route s -> t over the hierarchy. Returns its length in meters (TAK_HINGGA if t
+    // cannot be reached) and, if jalur is given, the nodes along it from s to t.
+    uint32_t cariJalur(uint32_t s, uint32_t t, vector<uint32_t>* jalur = nullptr) const {
+        if (jalur != nullptr) jalur->clear();
+        if (s >= nama.size() || t >= nama.size()) return TAK_HINGGA;
+        RuangCari& r = ruang();
+        r.siapkan(nama.size());
+        r.jarak[0][s] = 0;
+        r.jarak[1][t] = 0;
+        r.induk[0][s] = r.induk[1][t] = TIDAK_ADA;
+        r.disentuh.push_back(s);
+        r.disentuh.push_back(t);
+        r.dorong(0, 0, s);
+        r.dorong(1, 0, t);
+
+        uint32_t terbaik = TAK_HINGGA, temu = TIDAK_ADA;
+        while (true) {
+            uint32_t kunci0 = r.antrian[0].empty() ? TAK_HINGGA : r.antrian[0].front().first;
+            uint32_t kunci1 = r.antrian[1].empty() ? TAK_HINGGA : r.antrian[1].front().first;
+            int arah = kunci0 <= kunci1 ? 0 : 1;
+            if (min(kunci0, kunci1) >= terbaik) break; // Neither side can still improve the route
+            pair<uint32_t, uint32_t> atas = r.ambil(arah);
+            uint32_t d = atas.first, v = atas.second;
+            vector<uint32_t>& jarak = r.jarak[arah];
+            if (d > jarak[v]) continue;
+            uint32_t lawan = r.jarak[1 - arah][v];
+            if (lawan != TAK_HINGGA && d + lawan < terbaik) {
+                terbaik = d + lawan;
+                temu = v;
+            }
+            bool tertahan = false; // Stall on demand: a higher node already reaches v more cheaply
+            for (uint32_t i = awalNaik[v]; i < awalNaik[v + 1] && !tertahan; i++) {
+                uint32_t dw = jarak[naik[i].ke];
+                tertahan = dw != TAK_HINGGA && dw + naik[i].bobot < d;
+            }
+            if (tertahan) continue;
+            for (uint32_t i = awalNaik[v]; i < awalNaik[v + 1]; i++) {
+                const Busur& busur = naik[i];
+                uint32_t baru = d + busur.bobot;
+                if (baru < jarak[busur.ke]) {
+                    if (r.jarak[0][busur.ke] == TAK_HINGGA && r.jarak[1][busur.ke] == TAK_HINGGA) {
+                        r.disentuh.push_back(busur.ke);
+                    }
+                    jarak[busur.ke] = baru;
+                    r.induk[arah][busur.ke] = v;
+                    r.dorong(arah, baru, busur.ke);
+                }
+            }
+        }
+
+        if (jalur != nullptr && temu != TIDAK_ADA) {
+            vector<uint32_t> naikDariS; // s ... temu over hierarchy arcs
+            for (uint32_t v = temu; v != TIDAK_ADA; v = r.induk[0][v]) naikDariS.push_back(v);
+            reverse(naikDariS.begin(), naikDariS.end());
+            for (uint32_t v = r.induk[1][temu]; v != TIDAK_ADA; v = r.induk[1][v]) naikDariS.push_back(v);
+            jalur->push_back(s);
+            for (size_t i = 1; i < naikDariS.size(); i++) bukaBusur(naikDariS[i - 1], naikDariS[i], *jalur);
+        }
+        r.bersihkan();
+        return terbaik;
+    }
+
+    // Reference: Dijkstra from s over the original segments, same contract as cariJalur()
+    uint32_t cariJalurDijkstra(uint32_t s, uint32_t t, vector<uint32_t>* jalur = nullptr) const {
+        if (jalur != nullptr) jalur->clear();
+        if (s >= nama.size() || t >= nama.size()) return TAK_HINGGA;
+        RuangCari& r = ruang();
+        r.siapkan(nama.size());
+        vector<uint32_t>& jarak = r.jarak[0];
+        jarak[s] = 0;
+        r.induk[0][s] = TIDAK_ADA;
+        r.disentuh.push_back(s);
+        r.dorong(0, 0, s);
+        while (!r.antrian[0].empty()) {
+            pair<uint32_t, uint32_t> atas = r.ambil(0);
+            uint32_t d = atas.first, v = atas.second;
+            if (d > jarak[v]) continue;
+            if (v == t) break;
+            for (uint32_t i = awalTetangga[v]; i < awalTetangga[v + 1]; i++) {
+                const Busur& busur = tetangga[i];
+                uint32_t baru = d + busur.bobot;
+                if (baru < jarak[busur.ke]) {
+                    if (jarak[busur.ke] == TAK_HINGGA) r.disentuh.push_back(busur.ke);
+                    jarak[busur.ke] = baru;
+                    r.induk[0][busur.ke] = v;
+                    r.dorong(0, baru, busur.ke);
+                }
+            }
+        }
+        uint32_t hasil = jarak[t];
+        if (jalur != nullptr && hasil != TAK_HINGGA) {
+            for (uint32_t v = t; v != TIDAK_ADA; v = r.induk[0][v]) jalur->push_back(v);
+            reverse(jalur->begin(), jalur->end());
+        }
+        r.bersihkan();
+        return hasil;
+    }
+};
+
+const uint32_t GrafJalan::TIDAK_ADA;
+const uint32_t GrafJalan::TAK_HINGGA;
+const uint64_t GrafJalan::BATAS_PANJANG;
+
+// A computed route: nodes from start to destination and the total length
+struct RuteJalan {
+    vector<uint32_t> titik;
+    uint32_t meter;
+};
+
+// Route Cache - Bounded LRU of routes between arbitrary (start, destination) node pairs. A hit moves
+// the pair to the front; storing into a full cache drops the least recently used pair. Hits and
+// misses are counted so the capacity can be sized from real traffic. One mutex guards it all; a
+// lookup is a hash probe and a list splice.
+class CacheRute {
+private:
+    typedef list<pair<uint64_t, RuteJalan>> DaftarRute;
+
+    size_t kapasitas;
+    DaftarRute urutan; // Most recently used first
+    unordered_map<uint64_t, DaftarRute::iterator> indeks;
+    uint64_t hit = 0, miss = 0;
+    mutable mutex kunci;
+
+    static uint64_t kunciPasangan(uint32_t asal, uint32_t tujuan) {
+        return static_cast<uint64_t>(asal) << 32 | tujuan;
+    }
+
+public:
+    explicit CacheRute(size_t kapasitas) : kapasitas(kapasitas) {
+        indeks.reserve(kapasitas);
+    }
+
+    // Copies the cached route into rute; false (a miss) if the pair is not cached
+    bool ambil(uint32_t asal, uint32_t tujuan, RuteJalan& rute) {
+        lock_guard<mutex> lock(kunci);
+        auto it = indeks.find(kunciPasangan(asal, tujuan));
+        if (it == indeks.end()) {
+            miss++;
+            return false;
+        }
+        hit++;
+        urutan.splice(urutan.begin(), urutan, it->second);
+        rute = it->second->second;
+        return true;
+    }
+
+    void simpan(uint32_t asal, uint32_t tujuan, const RuteJalan& rute) {
+        if (kapasitas == 0) return;
+        uint64_t kunciRute = kunciPasangan(asal, tujuan);
+        lock_guard<mutex> lock(kunci);
+        auto it = indeks.find(kunciRute);
+        if (it != indeks.end()) { // Another thread computed the same pair meanwhile
+            urutan.splice(urutan.begin(), urutan, it->second);
+            return;
+        }
+        if (urutan.size() >= kapasitas) { // Reuse the evicted node for the new pair
+            indeks.erase(urutan.back().first);
+            urutan.splice(urutan.begin(), urutan, prev(urutan.end()));
+            urutan.front() = {kunciRute, rute};
+        } else {
+            urutan.push_front({kunciRute, rute});
+        }
+        indeks.emplace(kunciRute, urutan.begin());
+    }
+
+    // Drops every route (call after the graph is rebuilt); the counters are kept
+    void kosongkan() {
+        lock_guard<mutex> lock(kunci);
+        urutan.clear();
+        indeks.clear();
+    }
+
+    size_t ukuran() const { lock_guard<mutex> lock(kunci); return urutan.size(); }
+    size_t batas() const { return kapasitas; }
+    uint64_t jumlahHit() const { lock_guard<mutex> lock(kunci); return hit; }
+    uint64_t jumlahMiss() const { lock_guard<mutex> lock(kunci); return miss; }
+};
+
+// Contracts every node, least important first. A node's importance is its edge difference
+// (shortcuts its contraction would add minus arcs it removes) plus how many of its neighbors are
+// already contracted, which spreads contraction evenly over the graph. Priorities are refreshed
+// lazily: a node reaching the front is re-simulated and goes back if it is no longer the cheapest.
+// Witness searches stop once every other neighbor is settled and are bounded by settled nodes, so
+// a missed witness only adds a redundant shortcut.
+void GrafJalan::kontraksi() {
+    const size_t BATAS_SAKSI_SIMULASI = 60;
+    const size_t BATAS_SAKSI = 1000;
+    size_t n = nama.size();
+
+    vector<vector<Busur>> sisa(n); // Arcs among nodes not contracted yet
+    for (size_t v = 0; v < n; v++) {
+        for (uint32_t i = awalTetangga[v]; i < awalTetangga[v + 1]; i++) {
+            sambung(sisa[v], tetangga[i].ke, tetangga[i].bobot, TIDAK_ADA);
+        }
+    }
+
+    vector<uint32_t> jarakSaksi(n, TAK_HINGGA);
+    vector<uint32_t> disentuh;
+    vector<pair<uint32_t, uint32_t>> antrianSaksi;
+    vector<uint32_t> tandaTarget(n, TIDAK_ADA); // Search number a node is a target of
+    uint32_t nomorCari = 0;
+    // Dijkstra from sumber over the remaining graph without `lewati`, up to `batas` meters, until
+    // the `jumlahTarget` nodes marked with nomorCari are settled
+    auto cariSaksi = [&](uint32_t sumber, uint32_t lewati, uint32_t batas, size_t batasTitik, size_t jumlahTarget) {
+        for (uint32_t v : disentuh) jarakSaksi[v] = TAK_HINGGA;
+        disentuh.clear();
+        antrianSaksi.clear();
+        jarakSaksi[sumber] = 0;
+        disentuh.push_back(sumber);
+        antrianSaksi.push_back({0, sumber});
+        size_t selesai = 0;
+        while (!antrianSaksi.empty()) {
+            pop_heap(antrianSaksi.begin(), antrianSaksi.end(), greater<pair<uint32_t, uint32_t>>());
+            pair<uint32_t, uint32_t> atas = antrianSaksi.back();
+            antrianSaksi.pop_back();
+            if (atas.first > jarakSaksi[atas.second]) continue;
+            if (atas.first > batas || ++selesai > batasTitik) break;
+            if (tandaTarget[atas.second] == nomorCari && --jumlahTarget == 0) break;
+            for (const Busur& busur : sisa[atas.second]) {
+                if (busur.ke == lewati) continue;
+                uint32_t baru = atas.first + busur.bobot;
+                if (baru < jarakSaksi[busur.ke]) {
+                    if (jarakSaksi[busur.ke] == TAK_HINGGA) disentuh.push_back(busur.ke);
+                    jarakSaksi[busur.ke] = baru;
+                    antrianSaksi.push_back({baru, busur.ke});
+                    push_heap(antrianSaksi.begin(), antrianSaksi.end(), greater<pair<uint32_t, uint32_t>>());
+                }
+            }
+        }
+    };
+
+    struct Pintasan {
+        uint32_t u, w, bobot;
+    };
+    vector<Pintasan> pintasan;
+    // Shortcuts needed to contract v (pairs of neighbors with no witness path avoiding v)
+    auto hitungPintasan = [&](uint32_t v, size_t batasTitik) {
+        pintasan.clear();
+        const vector<Busur>& daftar = sisa[v];
+        uint32_t terjauh = 0;
+        for (const Busur& busur : daftar) terjauh = max(terjauh, busur.bobot);
+        for (size_t i = 0; i + 1 < daftar.size(); i++) {
+            nomorCari++;
+            for (size_t j = i + 1; j < daftar.size(); j++) tandaTarget[daftar[j].ke] = nomorCari;
+            cariSaksi(daftar[i].ke, v, daftar[i].bobot + terjauh, batasTitik, daftar.size() - i - 1);
+            for (size_t j = i + 1; j < daftar.size(); j++) {
+                uint32_t lewatV = daftar[i].bobot + daftar[j].bobot; // Arcs are at most BATAS_PANJANG: no overflow
+                if (jarakSaksi[daftar[j].ke] > lewatV && lewatV <= BATAS_PANJANG) { // A longer one is never shortest
+                    pintasan.push_back({daftar[i].ke, daftar[j].ke, lewatV});
+                }
+            }
+        }
+        return pintasan.size();
+    };
+
+    vector<uint32_t> terkontraksiTetangga(n, 0);
+    vector<int64_t> prioritas(n);
+    auto hitungPrioritas = [&](uint32_t v) {
+        int64_t selisih = static_cast<int64_t>(hitungPintasan(v, BATAS_SAKSI_SIMULASI)) - static_cast<int64_t>(sisa[v].size());
+        return 2 * selisih + terkontraksiTetangga[v];
+    };
+    typedef pair<int64_t, uint32_t> EntriPrioritas;
+    priority_queue<EntriPrioritas, vector<EntriPrioritas>, greater<EntriPrioritas>> antrian;
+    for (uint32_t v = 0; v < n; v++) {
+        prioritas[v] = hitungPrioritas(v);
+        antrian.push({prioritas[v], v});
+    }
+
+    peringkat.assign(n, TIDAK_ADA);
+    vector<vector<Busur>> naikPerTitik(n);
+    uint32_t urutan = 0;
+    while (!antrian.empty()) {
+        EntriPrioritas atas = antrian.top();
+        antrian.pop();
+        uint32_t v = atas.second;
+        if (peringkat[v] != TIDAK_ADA || atas.first != prioritas[v]) continue; // Stale entry
+        int64_t terbaru = hitungPrioritas(v);
+        if (terbaru > atas.first && !antrian.empty() && terbaru > antrian.top().first) {
+            prioritas[v] = terbaru;
+            antrian.push({terbaru, v});
+            continue;
+        }
+
+        hitungPintasan(v, BATAS_SAKSI);
+        peringkat[v] = urutan++;
+        naikPerTitik[v] = std::move(sisa[v]); // Every remaining neighbor is contracted later: upward arcs
+        vector<Busur>().swap(sisa[v]);
+        for (const Busur& busur : naikPerTitik[v]) {
+            vector<Busur>& daftar = sisa[busur.ke];
+            for (size_t i = 0; i < daftar.size(); i++) {
+                if (daftar[i].ke == v) {
+                    daftar[i] = daftar.back();
+                    daftar.pop_back();
+                    break;
+                }
+            }
+            terkontraksiTetangga[busur.ke]++;
+        }
+        for (const Pintasan& p : pintasan) {
+            sambung(sisa[p.u], p.w, p.bobot, v);
+            sambung(sisa[p.w], p.u, p.bobot, v);
+        }
+    }
+
+    awalNaik.assign(n + 1, 0);
+    for (size_t v = 0; v < n; v++) awalNaik[v + 1] = awalNaik[v] + static_cast<uint32_t>(naikPerTitik[v].size());
+    naik.clear();
+    naik.reserve(awalNaik[n]);
+    for (size_t v = 0; v < n; v++) {
+        naik.insert(naik.end(), naikPerTitik[v].begin(), naikPerTitik[v].end());
+        vector<Busur>().swap(naikPerTitik[v]);
+    }
+}
+
+// Terminal Renderer - In-process frame buffer for console screens
+// Installed as cout's streambuf in interactive mode. Everything a screen prints is appended to one
+// in-memory frame, and the frame goes out in a single write() when the program waits for input
+// (cout is tied to cin, so every read flushes it) or a new screen is started. Nothing is written
+// line by line. A frame that grows past BATAS_FRAME is written out early, so output keeps going
+// even when no read flushes it (stdin at EOF).
+class FrameBuffer : public streambuf {
+private:
+    static const size_t BATAS_FRAME = 1 << 20;
+
+    string frame;
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (ch != traits_type::eof()) {
+            frame.push_back(static_cast<char>(ch));
+            if (frame.size() >= BATAS_FRAME) flushFrame();
+        }
+        return ch;
+    }
+
+    streamsize xsputn(const char* s, streamsize n) override {
+        frame.append(s, static_cast<size_t>(n));
+        if (frame.size() >= BATAS_FRAME) flushFrame();
+        return n;
+    }
+
+    int sync() override {
+        flushFrame();
+        return 0;
+    }
+
+public:
+    FrameBuffer() { frame.reserve(1 << 16); }
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+    ~FrameBuffer() { flushFrame(); }
+
+    void flushFrame() {
+        size_t sent = 0;
+        while (sent < frame.size()) {
+#ifdef _WIN32
+            size_t n = fwrite(frame.data() + sent, 1, frame.size() - sent, stdout);
+            fflush(stdout);
+#else
+            ssize_t n = ::write(STDOUT_FILENO, frame.data() + sent, frame.size() - sent);
+            if (n < 0 && errno == EINTR) continue;
+#endif
+            if (n <= 0) break;
+            sent += static_cast<size_t>(n);
+        }
+        frame.clear();
+    }
+};
+
+// Puts a streambuf in place of a stream's own while alive and restores the original afterwards
+class GantiBuffer {
+private:
+    ios& stream;
+    streambuf* asli;
+
+public:
+    GantiBuffer(ios& s, streambuf* buffer) : stream(s), asli(s.rdbuf(buffer)) {}
+    GantiBuffer(const GantiBuffer&) = delete;
+    GantiBuffer& operator=(const GantiBuffer&) = delete;
+    ~GantiBuffer() { stream.rdbuf(asli); }
+};
+
+// Table layout with column widths and header lines computed once.
+// Rows are padded straight into a string, which replaces per-cell setw formatting.
+class TabelLayout {
+private:
+    vector<size_t> lebar; // Column widths
+    string garis;         // Separator line
+    string header;        // Header row
+
+public:
+    // Borrowed view of one cell's text, so rows can be rendered without copying strings
+    struct Sel {
+        const char* data;
+        size_t size;
+        Sel(const string& text) : data(text.data()), size(text.size()) {}
+        Sel(const char* text) : data(text), size(strlen(text)) {}
+    };
+
+    TabelLayout(initializer_list<pair<const char*, size_t>> kolom, size_t panjangGaris = 92)
+        : garis(string(panjangGaris, '-') + "\n") {
+        for (const auto& k : kolom) {
+            lebar.push_back(k.second);
+            appendCell(header, k.first, k.second);
+        }
+        header += '\n';
+    }
+
+    // Left-aligned cell: like setw, pads short text and never truncates long text
+    static void appendCell(string& out, Sel text, size_t width) {
+        out.append(text.data, text.size);
+        if (text.size < width) {
+            out.append(width - text.size, ' ');
+        }
+    }
+
+    void appendRow(string& out, initializer_list<Sel> cells) const {
+        size_t i = 0;
+        for (const Sel& cell : cells) {
+            appendCell(out, cell, i < lebar.size() ? lebar[i] : 0);
+            i++;
+        }
+        out += '\n';
+    }
+
+    void appendHeader(string& out) const {
+        out += garis;
+        out += header;
+        out += garis;
+    }
+};
+
+// Mutex that can live inside copyable structs: a copy gets its own fresh, unlocked mutex
+struct MutexSalinan {
+    mutable mutex m;
+    MutexSalinan() {}
+    MutexSalinan(const MutexSalinan&) {}
+    MutexSalinan& operator=(const MutexSalinan&) { return *this; }
+};
+
+// Instrumented operations (names double as the batch command names in metric dumps)
+enum class Operasi : uint8_t { Login, Pinjam, CariBuku, FilterBuku, LihatAntrean, DaftarKonsultasi, Rute, Rekomendasi, Riwayat, Kembali, Pesan, BatalKonsultasi, PindahKonsultasi, Jumlah };
+
+// Operation Metrics - A counter and a latency histogram per operation. Histograms are log-linear
+// like HDR histograms: 16 buckets per power of two, so any reported value is within about 6% of
+// the real one from 1 ns up to 2^40 ns. Every thread writes only to its own shard (relaxed atomic
+// stores, no locks, no shared cache lines); readers merge all shards, so a read is a snapshot
+// that may miss operations still being recorded. Shards outlive their threads so no count is lost.
+// Meant for one instance per process: each thread caches its shard in a thread_local.
+class MetrikOperasi {
+public:
+    static const size_t BIT_SUB = 4; // log2 of the buckets per power of two
+    static const size_t EKSPONEN_MAKS = 40;
+    static const size_t JUMLAH_BUCKET = (EKSPONEN_MAKS - BIT_SUB + 2) << BIT_SUB;
+    static const size_t JUMLAH_OPERASI = static_cast<size_t>(Operasi::Jumlah);
+
+    // Merged view of one operation
+    struct Ringkasan {
+        uint64_t jumlah = 0;
+        uint64_t totalNs = 0;
+        uint64_t maksNs = 0;
+        vector<uint64_t> bucket = vector<uint64_t>(JUMLAH_BUCKET, 0);
+
+        // Upper bound of the bucket holding the p-th percentile (0 < p <= 100), capped at the maximum
+        uint64_t persentil(double p) const {
+            if (jumlah == 0) return 0;
+            uint64_t target = static_cast<uint64_t>(p / 100.0 * jumlah + 0.5);
+            if (target == 0) target = 1;
+            uint64_t kumulatif = 0;
+            for (size_t i = 0; i < JUMLAH_BUCKET; i++) {
+                kumulatif += bucket[i];
+                if (kumulatif >= target) return min(batasAtas(i), maksNs);
+            }
+            return maksNs;
+        }
+
+        // What was recorded between `sebelum` and this later read of the same operation. The
+        // maximum is not kept per interval, so it becomes the upper bound of the highest bucket.
+        Ringkasan selisih(const Ringkasan& sebelum) const {
+            Ringkasan r;
+            r.jumlah = jumlah - sebelum.jumlah;
+            r.totalNs = totalNs - sebelum.totalNs;
+            for (size_t i = 0; i < JUMLAH_BUCKET; i++) {
+                r.bucket[i] = bucket[i] - sebelum.bucket[i];
+                if (r.bucket[i] != 0) r.maksNs = min(batasAtas(i), maksNs);
+            }
+            return r;
+        }
+    };
+
+private:
+    struct Shard {
+        atomic<uint64_t> bucket[JUMLAH_OPERASI][JUMLAH_BUCKET];
+        atomic<uint64_t> totalNs[JUMLAH_OPERASI];
+        atomic<uint64_t> maksNs[JUMLAH_OPERASI];
+
+        Shard() {
+            for (size_t op = 0; op < JUMLAH_OPERASI; op++) {
+                for (atomic<uint64_t>& b : bucket[op]) b.store(0, memory_order_relaxed);
+                totalNs[op].store(0, memory_order_relaxed);
+                maksNs[op].store(0, memory_order_relaxed);
+            }
+        }
+    };
+
+    mutable mutex kunci; // Guards the shard list, not the counts
+    vector<unique_ptr<Shard>> shard;
+
+    Shard& shardLokal() {
+        thread_local Shard* lokal = nullptr;
+        if (lokal == nullptr) {
+            lock_guard<mutex> lock(kunci);
+            shard.emplace_back(new Shard());
+            lokal = shard.back().get();
+        }
+        return *lokal;
+    }
+
+    // Only the owning thread writes a shard, so load + store is enough
+    static void tambah(atomic<uint64_t>& a, uint64_t n) {
+        a.store(a.load(memory_order_relaxed) + n, memory_order_relaxed);
+    }
+
+public:
+    static size_t indeksBucket(uint64_t ns) {
+        if (ns < (uint64_t(1) << BIT_SUB)) return static_cast<size_t>(ns);
+        size_t eksponen = 63 - static_cast<size_t>(__builtin_clzll(ns));
+        if (eksponen > EKSPONEN_MAKS) return JUMLAH_BUCKET - 1;
+        size_t sub = static_cast<size_t>(ns >> (eksponen - BIT_SUB)) & ((size_t(1) << BIT_SUB) - 1);
+        return ((eksponen - BIT_SUB + 1) << BIT_SUB) + sub;
+    }
+
+    // Largest value that falls into bucket i
+    static uint64_t batasAtas(size_t i) {
+        if (i < (size_t(1) << BIT_SUB)) return i;
+        size_t eksponen = (i >> BIT_SUB) + BIT_SUB - 1;
+        uint64_t sub = i & ((size_t(1) << BIT_SUB) - 1);
+        uint64_t lebar = uint64_t(1) << (eksponen - BIT_SUB);
+        return ((uint64_t(1) << BIT_SUB) + sub + 1) * lebar - 1;
+    }
+
+    static const char* nama(Operasi op) {
+        static const char* const NAMA[JUMLAH_OPERASI] = {"login", "borrow", "search", "filter", "queue", "register-consultation", "route", "recommend", "history", "return", "hold", "cancel-consultation", "move-consultation"};
+        return NAMA[static_cast<size_t>(op)];
+    }
+
+    void catat(Operasi op, uint64_t ns) {
+        Shard& s = shardLokal();
+        size_t i = static_cast<size_t>(op);
+        tambah(s.bucket[i][indeksBucket(ns)], 1);
+        tambah(s.totalNs[i], ns);
+        if (ns > s.maksNs[i].load(memory_order_relaxed)) s.maksNs[i].store(ns, memory_order_relaxed);
+    }
+
+    Ringkasan baca(Operasi op) const {
+        Ringkasan r;
+        size_t i = static_cast<size_t>(op);
+        lock_guard<mutex> lock(kunci);
+        for (const unique_ptr<Shard>& s : shard) {
+            for (size_t b = 0; b < JUMLAH_BUCKET; b++) {
+                uint64_t n = s->bucket[i][b].load(memory_order_relaxed);
+                r.bucket[b] += n;
+                r.jumlah += n;
+            }
+            r.totalNs += s->totalNs[i].load(memory_order_relaxed);
+            r.maksNs = max(r.maksNs, s->maksNs[i].load(memory_order_relaxed));
+        }
+        return r;
+    }
+
+    size_t jumlahShard() const {
+        lock_guard<mutex> lock(kunci);
+        return shard.size();
+    }
+};
+
+// Times one operation from construction to destruction
+class PengukurOperasi {
+private:
+    MetrikOperasi& metrik;
+    Operasi op;
+    chrono::steady_clock::time_point mulai;
+
+public:
+    PengukurOperasi(MetrikOperasi& metrik_, Operasi op_) : metrik(metrik_), op(op_), mulai(chrono::steady_clock::now()) {}
+    PengukurOperasi(const PengukurOperasi&) = delete;
+    PengukurOperasi& operator=(const PengukurOperasi&) = delete;
+    ~PengukurOperasi() {
+        auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - mulai).count();
+        metrik.catat(op, static_cast<uint64_t>(ns));
+    }
+};
+
+// Kinds of history entries
+enum class JenisAktivitas : uint8_t {
+    PinjamBuku = 1,       // ref = catalog slot of the book
+    DaftarKonsultasi = 2, // ref = mentor ID in the registry
+    KembalikanBuku = 3,   // ref = catalog slot of the book
+    Terlambat = 4,        // ref = catalog slot of the overdue book; time = its due date
+    PesanBuku = 5,        // ref = catalog slot of the book the student is waiting for
+    TerimaPesanan = 6,    // ref = catalog slot of a held book handed over on its return (the loan)
+    BatalKonsultasi = 7,  // ref = mentor ID in the registry
+    PindahKonsultasi = 8  // ref = mentor ID in the registry
+};
+
+// One history entry: what happened, when, and to which book or mentor. 16 bytes and no heap;
+// the display text is built from the catalog and the registry only when a history is rendered.
+struct Aktivitas {
+    int64_t waktu; // Unix time in seconds
+    uint32_t ref;
+    JenisAktivitas jenis;
+};
+
+// Data for Student
+struct Mahasiswa {
+    string nim;
+    string password;
+    string nama;
+    LinkedList<Aktivitas> riwayat_peminjaman; // Loans only
+    LinkedList<Aktivitas> riwayat_aktivitas; // Every activity, loans included
+    vector<uint32_t> pinjaman_terakhir; // Last distinct books borrowed, oldest first (for co-borrow counts; rebuilt from the loans)
+    vector<uint32_t> pesanan_aktif; // Catalog slots the student is waiting for, in hold order (rebuilt from the holds)
+    bool sudah_daftar_konsultasi; // Indicates if student has registered for consultation
+    string dosen_konsultasi_terdaftar; // Stores the mentor's name if registered
+    MutexSalinan kunci; // Guards both histories, the held books and the consultation fields when several threads serve this student
+    
+    // Default constructor
+    Mahasiswa() : sudah_daftar_konsultasi(false), dosen_konsultasi_terdaftar("") {}
+
+    // Parameterized constructor for initial student setup
+    Mahasiswa(string n, string p, string nm)
+        : nim(n), password(p), nama(nm),
+          sudah_daftar_konsultasi(false), 
+          dosen_konsultasi_terdaftar("") {}
+};
+
+// Hierarchical Timing Wheel - Timers carrying a 32-bit key, due at whole seconds. Level l has 64
+// slots for the timers whose due time first differs from the wheel's current time in bits
+// [6l, 6l + 6), at the slot given by those bits; eleven levels cover every 64-bit time. A mask per
+// level marks occupied slots, so advancing jumps straight to the next occupied slot instead of
+// ticking through idle seconds, and a slot reached on a higher level is cascaded into the lower
+// ones. Scheduling and cancelling are O(1); a timer moves down at most ten times before it fires.
+// Timer nodes live in one vector, link by index and are reused through a free list.
+class RodaWaktu {
+public:
+    static const uint32_t TIDAK_ADA = static_cast<uint32_t>(-1);
+    static const size_t BIT_SLOT = 6;
+    static const size_t JUMLAH_SLOT = size_t(1) << BIT_SLOT;
+    static const size_t JUMLAH_LEVEL = 11;
+
+private:
+    static const size_t POSISI_JATUH = JUMLAH_LEVEL * JUMLAH_SLOT; // Extra list: already due
+
+    struct Timer {
+        int64_t waktu;
+        uint32_t kunci;
+        uint32_t prev, next;
+        uint16_t posisi; // level * JUMLAH_SLOT + slot, or POSISI_JATUH
+    };
+
+    vector<Timer> timer;
+    uint32_t bebas = TIDAK_ADA; // Free nodes, linked through next
+    uint32_t kepala[POSISI_JATUH + 1];
+    uint64_t terisi[JUMLAH_LEVEL] = {};
+    int64_t sekarang_;
+    size_t jumlah = 0;
+
+    void sisipkan(uint32_t h) {
+        Timer& t = timer[h];
+        size_t posisi = POSISI_JATUH;
+        if (t.waktu > sekarang_) {
+            uint64_t beda = static_cast<uint64_t>(t.waktu) ^ static_cast<uint64_t>(sekarang_);
+            size_t level = (63 - static_cast<size_t>(__builtin_clzll(beda))) / BIT_SLOT;
+            size_t slot = (static_cast<uint64_t>(t.waktu) >> (level * BIT_SLOT)) & (JUMLAH_SLOT - 1);
+            posisi = level * JUMLAH_SLOT + slot;
+            terisi[level] |= uint64_t(1) << slot;
+        }
+        t.posisi = static_cast<uint16_t>(posisi);
+        t.prev = TIDAK_ADA;
+        t.next = kepala[posisi];
+        if (t.next != TIDAK_ADA) timer[t.next].prev = h;
+        kepala[posisi] = h;
+    }
+
+    void lepas(uint32_t h) {
+        Timer& t = timer[h];
+        if (t.prev != TIDAK_ADA) timer[t.prev].next = t.next;
+        else kepala[t.posisi] = t.next;
+        if (t.next != TIDAK_ADA) timer[t.next].prev = t.prev;
+        if (kepala[t.posisi] == TIDAK_ADA && t.posisi != POSISI_JATUH) {
+            terisi[t.posisi / JUMLAH_SLOT] &= ~(uint64_t(1) << (t.posisi % JUMLAH_SLOT));
+        }
+    }
+
+public:
+    explicit RodaWaktu(int64_t mulai = 0) : sekarang_(mulai) {
+        fill(begin(kepala), end(kepala), TIDAK_ADA);
+    }
+
+    // Schedules `kunci` at `waktu` and returns the timer handle; a time not after the wheel's
+    // current time fires on the next advance
+    uint32_t jadwalkan(uint32_t kunci, int64_t waktu) {
+        uint32_t h;
+        if (bebas != TIDAK_ADA) {
+            h = bebas;
+            bebas = timer[h].next;
+        } else {
+            h = static_cast<uint32_t>(timer.size());
+            timer.emplace_back();
+        }
+        timer[h].waktu = waktu;
+        timer[h].kunci = kunci;
+        sisipkan(h);
+        jumlah++;
+        return h;
+    }
+
+    // Removes a timer that has not fired yet
+    void batalkan(uint32_t h) {
+        lepas(h);
+        timer[h].next = bebas;
+        bebas = h;
+        jumlah--;
+    }
+
+    // Moves the current time forward to `waktu`, calling saatJatuh(kunci, due time) for every timer
+    // due by then, in due-time order up to a second. Handles of fired timers become invalid.
+    template <typename F>
+    void maju(int64_t waktu, F&& saatJatuh) {
+        while (true) {
+            while (kepala[POSISI_JATUH] != TIDAK_ADA) {
+                uint32_t h = kepala[POSISI_JATUH];
+                uint32_t kunci = timer[h].kunci;
+                int64_t jatuh = timer[h].waktu;
+                batalkan(h);
+                saatJatuh(kunci, jatuh);
+            }
+
+            // The lowest occupied level holds the next slot to reach: any slot of a higher level
+            // starts in a later block of the lower one
+            size_t level = 0;
+            while (level < JUMLAH_LEVEL && terisi[level] == 0) level++;
+            if (level == JUMLAH_LEVEL) break;
+            size_t geser = level * BIT_SLOT;
+            uint64_t kini = static_cast<uint64_t>(sekarang_);
+            size_t slotKini = (kini >> geser) & (JUMLAH_SLOT - 1);
+            uint64_t sesudah = terisi[level] & ~((uint64_t(2) << slotKini) - 1); // Slots above the current one
+            size_t slot = static_cast<size_t>(__builtin_ctzll(sesudah));
+            uint64_t atas = geser + BIT_SLOT >= 64 ? 0 : (kini >> (geser + BIT_SLOT)) << (geser + BIT_SLOT);
+            int64_t awalSlot = static_cast<int64_t>(atas | (uint64_t(slot) << geser));
+            if (awalSlot > waktu) break;
+
+            sekarang_ = awalSlot;
+            size_t posisi = level * JUMLAH_SLOT + slot;
+            uint32_t h = kepala[posisi];
+            kepala[posisi] = TIDAK_ADA;
+            terisi[level] &= ~(uint64_t(1) << slot);
+            while (h != TIDAK_ADA) {
+                uint32_t next = timer[h].next;
+                sisipkan(h); // Lands on a lower level, or in the due list
+                h = next;
+            }
+        }
+        if (waktu > sekarang_) sekarang_ = waktu;
+    }
+
+    int64_t sekarang() const { return sekarang_; }
+    size_t size() const { return jumlah; }
+};
+
+const uint32_t RodaWaktu::TIDAK_ADA;
+
+// Outstanding Loans - The loan of every borrowed catalog slot (books are single copies) with its
+// due date on a timing wheel, so overdue loans are found without scanning the loans. Sharded by
+// slot, one wheel per shard; overdue loans stay recorded until returned but leave the wheel.
+class RegistriPinjaman {
+public:
+    struct Pinjaman {
+        string nim;
+        int64_t waktuPinjam;
+        int64_t jatuhTempo;
+        uint32_t timer; // Handle in the shard's wheel, RodaWaktu::TIDAK_ADA once overdue
+
+        bool terlambat() const { return timer == RodaWaktu::TIDAK_ADA; }
+    };
+
+    // A loan that just became overdue
+    struct Jatuh {
+        uint32_t slot;
+        string nim;
+        int64_t jatuhTempo;
+    };
+
+private:
+    struct ShardPinjaman {
+        mutable mutex kunci;
+        unordered_map<uint32_t, Pinjaman> pinjaman;
+        RodaWaktu roda{LayananWaktu::sekarang()};
+    };
+    static const size_t JUMLAH_SHARD = 64;
+
+    ShardPinjaman shard[JUMLAH_SHARD];
+
+    ShardPinjaman& shardUntuk(uint32_t slot) { return shard[slot % JUMLAH_SHARD]; }
+    const ShardPinjaman& shardUntuk(uint32_t slot) const { return shard[slot % JUMLAH_SHARD]; }
+
+public:
+    // Records a loan (replacing any earlier one of the slot); an overdue loan is not scheduled
+    void catat(uint32_t slot, const string& nim, int64_t waktuPinjam, int64_t jatuhTempo, bool terlambat = false) {
+        ShardPinjaman& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.pinjaman.find(slot);
+        if (it != s.pinjaman.end() && !it->second.terlambat()) s.roda.batalkan(it->second.timer);
+        uint32_t timer = terlambat ? RodaWaktu::TIDAK_ADA : s.roda.jadwalkan(slot, jatuhTempo);
+        s.pinjaman[slot] = {nim, waktuPinjam, jatuhTempo, timer};
+    }
+
+    // Ends the loan of the slot if `nim` holds it; `hasil` receives the ended loan
+    bool akhiri(uint32_t slot, const string& nim, Pinjaman& hasil) {
+        ShardPinjaman& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.pinjaman.find(slot);
+        if (it == s.pinjaman.end() || it->second.nim != nim) return false;
+        if (!it->second.terlambat()) s.roda.batalkan(it->second.timer);
+        hasil = std::move(it->second);
+        s.pinjaman.erase(it);
+        return true;
+    }
+
+    bool cari(uint32_t slot, Pinjaman& hasil) const {
+        const ShardPinjaman& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.pinjaman.find(slot);
+        if (it == s.pinjaman.end()) return false;
+        hasil = it->second;
+        return true;
+    }
+
+    // Takes the loan off the wheel without reporting it (an overdue event being replayed)
+    void tandaiTerlambat(uint32_t slot) {
+        ShardPinjaman& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.pinjaman.find(slot);
+        if (it == s.pinjaman.end() || it->second.terlambat()) return;
+        s.roda.batalkan(it->second.timer);
+        it->second.timer = RodaWaktu::TIDAK_ADA;
+    }
+
+    // Advances every wheel to `waktu` and appends the loans that became overdue by then
+    void periksa(int64_t waktu, vector<Jatuh>& jatuh) {
+        for (ShardPinjaman& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            s.roda.maju(waktu, [&](uint32_t slot, int64_t jatuhTempo) {
+                Pinjaman& p = s.pinjaman[slot];
+                p.timer = RodaWaktu::TIDAK_ADA;
+                jatuh.push_back({slot, p.nim, jatuhTempo});
+            });
+        }
+    }
+
+    // Calls f(slot, loan) for every loan, one shard locked at a time
+    template <typename F>
+    void untukSetiap(F&& f) const {
+        for (const ShardPinjaman& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            for (const auto& entri : s.pinjaman) f(entri.first, entri.second);
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const ShardPinjaman& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            total += s.pinjaman.size();
+        }
+        return total;
+    }
+};
+
+// Node Pool - Nodes handed out by 32-bit index from chunks of 4096 that are never moved or
+// freed while the pool lives. Released nodes are reset and chained through their own `next`
+// field (T needs a uint32_t next), so millions of short-lived nodes cost one heap block per
+// chunk and freed memory is reused instead of fragmenting the heap.
+template <typename T>
+class PoolSimpul {
+public:
+    static const uint32_t KOSONG = static_cast<uint32_t>(-1);
+
+private:
+    static const size_t BIT_CHUNK = 12;
+    static const size_t UKURAN_CHUNK = size_t(1) << BIT_CHUNK;
+
+    vector<unique_ptr<T[]>> chunks;
+    uint32_t terpakai = 0; // Nodes handed out at least once
+    uint32_t bebas = KOSONG;
+    size_t hidup = 0;
+
+public:
+    uint32_t alokasi(T nilai) {
+        uint32_t i;
+        if (bebas != KOSONG) {
+            i = bebas;
+            bebas = (*this)[i].next;
+        } else {
+            if (terpakai == chunks.size() * UKURAN_CHUNK) chunks.emplace_back(new T[UKURAN_CHUNK]);
+            i = terpakai++;
+        }
+        (*this)[i] = std::move(nilai);
+        hidup++;
+        return i;
+    }
+
+    void lepas(uint32_t i) {
+        T& simpul = (*this)[i];
+        simpul = T(); // Drops anything the node owns
+        simpul.next = bebas;
+        bebas = i;
+        hidup--;
+    }
+
+    T& operator[](uint32_t i) { return chunks[i >> BIT_CHUNK][i & (UKURAN_CHUNK - 1)]; }
+    const T& operator[](uint32_t i) const { return chunks[i >> BIT_CHUNK][i & (UKURAN_CHUNK - 1)]; }
+    size_t size() const { return hidup; }
+    size_t kapasitas() const { return chunks.size() * UKURAN_CHUNK; }
+};
+
+// Book Holds - A FIFO waitlist per catalog slot for books that are out on loan. Holds are pooled
+// nodes linked front to back; each carries a ticket, so a position is its ticket minus the
+// ticket at the front, plus one. A linear-probing (slot, NIM) -> node table finds a student's
+// hold in O(1) without a heap node per entry. Sharded by slot; the availability check when a
+// hold is placed and the hand-off when a book comes back happen under the same shard lock, so a
+// returned book can never sit on the shelf while students wait for it.
+class AntreanPesanan {
+public:
+    struct Pesanan {
+        string nim;
+        int64_t waktu = 0;
+        uint64_t tiket = 0;
+        uint32_t slot = 0;
+        uint32_t next = PoolSimpul<Pesanan>::KOSONG;
+    };
+
+    enum class Hasil { Ditambahkan, Tersedia, SudahMengantre };
+
+private:
+    static const uint32_t KOSONG = PoolSimpul<Pesanan>::KOSONG;
+
+    struct Antrean {
+        uint32_t depan = KOSONG;
+        uint32_t belakang = KOSONG;
+        uint64_t tiketDepan = 0;
+        uint64_t tiketBerikut = 0;
+    };
+
+    struct ShardPesanan {
+        mutable mutex kunci;
+        PoolSimpul<Pesanan> pool;
+        unordered_map<uint32_t, Antrean> antrean; // Only books with at least one hold
+        vector<uint32_t> indeks = vector<uint32_t>(64, uint32_t{KOSONG}); // Open-addressed, power-of-two size
+    };
+    static const size_t JUMLAH_SHARD = 64;
+
+    ShardPesanan shard[JUMLAH_SHARD];
+
+    ShardPesanan& shardUntuk(uint32_t slot) { return shard[slot % JUMLAH_SHARD]; }
+    const ShardPesanan& shardUntuk(uint32_t slot) const { return shard[slot % JUMLAH_SHARD]; }
+
+    static size_t hashKunci(uint32_t slot, const string& nim) {
+        return hash<string>()(nim) ^ (size_t(slot) * 0x9E3779B97F4A7C15ull);
+    }
+
+    // Index position holding the student's hold for the slot, or the empty position where it would go
+    static size_t cariPosisi(const ShardPesanan& s, uint32_t slot, const string& nim) {
+        size_t mask = s.indeks.size() - 1;
+        size_t i = hashKunci(slot, nim) & mask;
+        while (s.indeks[i] != KOSONG) {
+            const Pesanan& p = s.pool[s.indeks[i]];
+            if (p.slot == slot && p.nim == nim) break;
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    static void tumbuh(ShardPesanan& s) {
+        vector<uint32_t> lama(s.indeks.size() * 2, uint32_t{KOSONG});
+        lama.swap(s.indeks);
+        for (uint32_t simpul : lama) {
+            if (simpul != KOSONG) s.indeks[cariPosisi(s, s.pool[simpul].slot, s.pool[simpul].nim)] = simpul;
+        }
+    }
+
+    // Backward-shift deletion keeps every probe chain unbroken without tombstones
+    static void hapusIndeks(ShardPesanan& s, size_t i) {
+        size_t mask = s.indeks.size() - 1;
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (s.indeks[j] == KOSONG) break;
+            const Pesanan& p = s.pool[s.indeks[j]];
+            size_t ideal = hashKunci(p.slot, p.nim) & mask;
+            if (((j - ideal) & mask) >= ((j - i) & mask)) { // Its home is at or before the gap
+                s.indeks[i] = s.indeks[j];
+                i = j;
+            }
+        }
+        s.indeks[i] = KOSONG;
+    }
+
+public:
+    // Puts the student at the back of the slot's line unless the book is on the shelf or the
+    // student is already waiting; `posisi` receives the 1-based position in either case
+    Hasil tambah(uint32_t slot, const string& nim, int64_t waktu, const KatalogBuku& katalog, size_t& posisi) {
+        ShardPesanan& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        posisi = 0;
+        size_t i = cariPosisi(s, slot, nim);
+        if (s.indeks[i] != KOSONG) {
+            posisi = static_cast<size_t>(s.pool[s.indeks[i]].tiket - s.antrean[slot].tiketDepan + 1);
+            return Hasil::SudahMengantre;
+        }
+        if (katalog.isTersedia(slot)) return Hasil::Tersedia;
+
+        Antrean& a = s.antrean[slot];
+        Pesanan p;
+        p.nim = nim;
+        p.waktu = waktu;
+        p.tiket = a.tiketBerikut++;
+        p.slot = slot;
+        uint32_t simpul = s.pool.alokasi(std::move(p));
+        if (a.belakang == KOSONG) a.depan = simpul;
+        else s.pool[a.belakang].next = simpul;
+        a.belakang = simpul;
+        s.indeks[i] = simpul;
+        if (s.pool.size() * 2 > s.indeks.size()) tumbuh(s);
+        posisi = static_cast<size_t>(a.tiketBerikut - a.tiketDepan);
+        return Hasil::Ditambahkan;
+    }
+
+    // 1-based position of the student in the slot's line, or 0 if not waiting
+    size_t posisi(uint32_t slot, const string& nim) const {
+        const ShardPesanan& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        uint32_t simpul = s.indeks[cariPosisi(s, slot, nim)];
+        if (simpul == KOSONG) return 0;
+        return static_cast<size_t>(s.pool[simpul].tiket - s.antrean.at(slot).tiketDepan + 1);
+    }
+
+    size_t panjang(uint32_t slot) const {
+        const ShardPesanan& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.antrean.find(slot);
+        return it == s.antrean.end() ? 0 : static_cast<size_t>(it->second.tiketBerikut - it->second.tiketDepan);
+    }
+
+    // For a book coming back: takes the first hold into `hasil` (the book stays out, now for that
+    // student), or puts the book back on the shelf if nobody is waiting
+    bool serahkanAtauKembalikan(uint32_t slot, KatalogBuku& katalog, Pesanan& hasil) {
+        ShardPesanan& s = shardUntuk(slot);
+        lock_guard<mutex> lock(s.kunci);
+        auto it = s.antrean.find(slot);
+        if (it == s.antrean.end()) {
+            katalog.setTersedia(slot, true);
+            return false;
+        }
+        Antrean& a = it->second;
+        uint32_t simpul = a.depan;
+        hasil = s.pool[simpul];
+        hapusIndeks(s, cariPosisi(s, slot, hasil.nim));
+        a.depan = s.pool[simpul].next;
+        a.tiketDepan++;
+        s.pool.lepas(simpul);
+        if (a.depan == KOSONG) s.antrean.erase(it);
+        return true;
+    }
+
+    // Calls f(hold) for every hold, each line from front to back, one shard locked at a time
+    template <typename F>
+    void untukSetiap(F&& f) const {
+        for (const ShardPesanan& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            for (const auto& entri : s.antrean) {
+                for (uint32_t simpul = entri.second.depan; simpul != KOSONG; simpul = s.pool[simpul].next) f(s.pool[simpul]);
+            }
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const ShardPesanan& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            total += s.pool.size();
+        }
+        return total;
+    }
+
+    // Bytes held by the pools and indexes (the per-book line headers not included)
+    size_t byteTerpakai() const {
+        size_t total = 0;
+        for (const ShardPesanan& s : shard) {
+            lock_guard<mutex> lock(s.kunci);
+            total += s.pool.kapasitas() * sizeof(Pesanan) + s.indeks.size() * sizeof(uint32_t);
+        }
+        return total;
+    }
+};
+
+// Encoder for the snapshot and WAL formats: fixed-width integers in host byte order and
+// u32-length-prefixed strings, appended to one buffer
+struct PenulisBiner {
+    string data;
+
+    void u8(uint8_t v) { data += static_cast<char>(v); }
+    void u32(uint32_t v) { data.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void u64(uint64_t v) { data.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void str(const string& s) {
+        u32(static_cast<uint32_t>(s.size()));
+        data += s;
+    }
+};
+
+// Decoder over a byte range (e.g. a memory-mapped file). Reading past the end clears `ok` and
+// returns zero values instead of touching memory outside the range.
+struct PembacaBiner {
+    const char* p;
+    const char* akhir;
+    bool ok;
+
+    PembacaBiner(const char* awal, const char* akhir_) : p(awal), akhir(akhir_), ok(true) {}
+
+    bool cukup(size_t n) {
+        if (ok && static_cast<size_t>(akhir - p) >= n) return true;
+        ok = false;
+        return false;
+    }
+    uint8_t u8() { return cukup(1) ? static_cast<uint8_t>(*p++) : 0; }
+    uint32_t u32() {
+        uint32_t v = 0;
+        if (cukup(sizeof(v))) { memcpy(&v, p, sizeof(v)); p += sizeof(v); }
+        return v;
+    }
+    uint64_t u64() {
+        uint64_t v = 0;
+        if (cukup(sizeof(v))) { memcpy(&v, p, sizeof(v)); p += sizeof(v); }
+        return v;
+    }
+    string str() {
+        uint32_t n = u32();
+        if (!cukup(n)) return "";
+        string s(p, n);
+        p += n;
+        return s;
+    }
+    void lewatiStr() {
+        lewati(u32());
+    }
+    void lewati(size_t n) {
+        if (cukup(n)) p += n;
+    }
+};
+
+// FNV-1a, used to detect torn or corrupted WAL records
+inline uint32_t checksumFnv1a(const char* data, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ static_cast<uint8_t>(data[i])) * 16777619u;
+    }
+    return h;
+}
+
+// Kinds of events in the write-ahead log
+enum class TipeWal : uint8_t {
+    Pinjam = 1,    // nim, book ID, u64 time: book marked borrowed, loan + activity recorded
+    Daftar = 2,    // nim, mentor code, u64 time: student booked into the earliest free session, activity recorded
+    Aktivitas = 3, // nim, u8 kind, u64 time, u32 ref: a plain activity entry (overdue loans)
+    Kembali = 4,   // nim, book ID, u64 time: loan ended, book handed to the next hold or shelved, activities recorded
+    Pesan = 5,     // nim, book ID, u64 time: student put in line for the book, activity recorded
+    Batal = 6,     // nim, u64 time: consultation booking cancelled, activity recorded
+    Pindah = 7     // nim, u64 earliest start, u64 time: booking moved to the first free session after it, activity recorded
+};
+
+#ifndef _WIN32
+
+// Writes the whole buffer, retrying short writes; returns false on an I/O error
+inline bool tulisSemua(int fd, const char* data, size_t n) {
+    size_t sent = 0;
+    while (sent < n) {
+        ssize_t w = ::write(fd, data + sent, n - sent);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<size_t>(w);
+    }
+    return true;
+}
+
+// Write-Ahead Log - Append-only event log with group commit
+// append() encodes a record, gives it the next log sequence number (LSN) and returns without
+// touching the disk. A background writer takes everything appended since its last round and
+// makes it durable with one write() and one fdatasync(), so concurrent appends share a sync.
+// tunggu(lsn) blocks until that record is durable. A failed write or sync ends the process.
+// Record: [u32 payload length][u32 FNV-1a of payload][payload = u64 lsn, u8 type, fields...]
+class WriteAheadLog {
+private:
+    int fd;
+    mutable mutex kunci;
+    condition_variable adaData;       // Wakes the writer
+    condition_variable sudahDurable;  // Wakes callers waiting in tunggu()
+    string antrean;                   // Encoded records not written yet
+    uint64_t lsnTerakhir;             // LSN of the last appended record
+    uint64_t lsnDurable;              // Every record up to this LSN is on disk
+    size_t jumlahRekaman;             // Records in the file since the last truncation
+    size_t jumlahSync;                // Group commits performed
+    bool berhenti;
+    thread penulis;
+
+    void loopPenulis() {
+        unique_lock<mutex> lock(kunci);
+        while (true) {
+            adaData.wait(lock, [this] { return berhenti || !antrean.empty(); });
+            if (antrean.empty()) break; // Stopping and nothing left to write
+            string batch;
+            batch.swap(antrean);
+            uint64_t lsnBatch = lsnTerakhir;
+            lock.unlock();
+
+            bool ok = tulisSemua(fd, batch.data(), batch.size());
+#ifdef __APPLE__
+            ok = ok && fsync(fd) == 0;
+#else
+            ok = ok && fdatasync(fd) == 0;
+#endif
+            if (!ok) {
+                // The file may now end in a torn record that replay would stop at, and a failed
+                // fdatasync may have dropped dirty pages: nothing from here on can be confirmed.
+                // Stop before any waiter is woken; the next start replays up to the last good record.
+                cerr << "WAL gagal ditulis: " << strerror(errno) << "\n";
+                _exit(1);
+            }
+
+            lock.lock();
+            lsnDurable = lsnBatch;
+            jumlahSync++;
+            sudahDurable.notify_all();
+        }
+    }
+
+public:
+    // Takes ownership of an open, append-mode file descriptor positioned after the last good record
+    WriteAheadLog(int fd_, uint64_t lsnAwal, size_t rekamanAwal)
+        : fd(fd_), lsnTerakhir(lsnAwal), lsnDurable(lsnAwal), jumlahRekaman(rekamanAwal),
+          jumlahSync(0), berhenti(false), penulis(&WriteAheadLog::loopPenulis, this) {}
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Writes out everything still pending, then stops the writer
+    ~WriteAheadLog() {
+        {
+            lock_guard<mutex> lock(kunci);
+            berhenti = true;
+        }
+        adaData.notify_one();
+        penulis.join();
+        close(fd);
+    }
+
+    // Frames the event fields and queues the record; returns its LSN
+    uint64_t append(TipeWal tipe, const PenulisBiner& isi) {
+        string frame(8 + 9 + isi.data.size(), '\0');
+        uint32_t panjang = static_cast<uint32_t>(9 + isi.data.size());
+        memcpy(&frame[0], &panjang, 4);
+        frame[16] = static_cast<char>(tipe);
+        memcpy(&frame[17], isi.data.data(), isi.data.size());
+
+        lock_guard<mutex> lock(kunci);
+        uint64_t lsn = ++lsnTerakhir;
+        memcpy(&frame[8], &lsn, 8);
+        uint32_t checksum = checksumFnv1a(frame.data() + 8, panjang);
+        memcpy(&frame[4], &checksum, 4);
+        antrean += frame;
+        jumlahRekaman++;
+        adaData.notify_one();
+        return lsn;
+    }
+
+    void tunggu(uint64_t lsn) {
+        unique_lock<mutex> lock(kunci);
+        sudahDurable.wait(lock, [this, lsn] { return lsnDurable >= lsn; });
+    }
+
+    // Waits until everything appended so far is durable and returns the last LSN
+    uint64_t flush() {
+        uint64_t lsn;
+        {
+            lock_guard<mutex> lock(kunci);
+            lsn = lsnTerakhir;
+        }
+        tunggu(lsn);
+        return lsn;
+    }
+
+    // Drops the log contents once a snapshot covers them. Records appended after the snapshot
+    // was taken keep the file intact (replay skips the covered ones by LSN).
+    void kosongkan(uint64_t lsnSnapshot) {
+        unique_lock<mutex> lock(kunci);
+        sudahDurable.wait(lock, [this] { return antrean.empty() && lsnDurable == lsnTerakhir; });
+        if (lsnTerakhir == lsnSnapshot && ftruncate(fd, 0) == 0) {
+            jumlahRekaman = 0;
+        }
+    }
+
+    uint64_t lsn() const { lock_guard<mutex> lock(kunci); return lsnTerakhir; }
+    size_t rekaman() const { lock_guard<mutex> lock(kunci); return jumlahRekaman; }
+    size_t sync() const { lock_guard<mutex> lock(kunci); return jumlahSync; }
+};
+
+// Read-only view of a snapshot file mapped into memory. Students stay encoded in the mapping
+// and are found by binary search over an offset index sorted by NIM, so opening a snapshot
+// costs the same for five students or a million.
+// Layout: [header][student records][catalog: mentors with queues, books with availability,
+//          co-borrow rows, open loans, holds in line order]
+//         [index: u64 record offset per student, sorted by NIM]
+// Header: "SSNAP006", u64 lsn, u64 student count, u64 catalog offset, u64 index offset
+class SnapshotTerpetakan {
+private:
+    const char* data;
+    size_t ukuran;
+    uint64_t lsnSnapshot;
+    uint64_t jumlah;
+    uint64_t offKatalog;
+    uint64_t offIndeks;
+
+    uint64_t offsetRekaman(uint64_t i) const {
+        uint64_t off;
+        memcpy(&off, data + offIndeks + i * 8, 8);
+        return off;
+    }
+
+public:
+    static const size_t UKURAN_HEADER = 40;
+
+    SnapshotTerpetakan() : data(nullptr), ukuran(0), lsnSnapshot(0), jumlah(0), offKatalog(0), offIndeks(0) {}
+    SnapshotTerpetakan(const SnapshotTerpetakan&) = delete;
+    SnapshotTerpetakan& operator=(const SnapshotTerpetakan&) = delete;
+    ~SnapshotTerpetakan() { tutup(); }
+
+    // 1 if opened, 0 if the file does not exist, -1 if it exists but is not a valid snapshot
+    int buka(const string& path) {
+        tutup();
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return errno == ENOENT ? 0 : -1;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < UKURAN_HEADER) {
+            close(fd);
+            return -1;
+        }
+        void* peta = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping stays valid without the descriptor
+        if (peta == MAP_FAILED) return -1;
+        data = static_cast<const char*>(peta);
+        ukuran = static_cast<size_t>(st.st_size);
+
+        PembacaBiner header(data + 8, data + UKURAN_HEADER);
+        lsnSnapshot = header.u64();
+        jumlah = header.u64();
+        offKatalog = header.u64();
+        offIndeks = header.u64();
+        if (memcmp(data, "SSNAP006", 8) != 0 || offKatalog < UKURAN_HEADER || offKatalog > offIndeks ||
+            offIndeks > ukuran || (ukuran - offIndeks) / 8 < jumlah) {
+            tutup();
+            return -1;
+        }
+        madvise(const_cast<char*>(data) + offIndeks, jumlah * 8, MADV_WILLNEED); // Searched on every lookup
+        return 1;
+    }
+
+    void tutup() {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), ukuran);
+        }
+        data = nullptr;
+        ukuran = 0;
+        lsnSnapshot = jumlah = offKatalog = offIndeks = 0;
+    }
+
+    bool terbuka() const { return data != nullptr; }
+    uint64_t lsn() const { return lsnSnapshot; }
+    uint64_t jumlahMahasiswa() const { return jumlah; }
+
+    // Reader positioned at the student's record, or one with ok == false if the NIM is absent
+    PembacaBiner cariRekaman(const string& nim) const {
+        uint64_t lo = 0, hi = jumlah;
+        while (lo < hi) {
+            uint64_t mid = lo + (hi - lo) / 2;
+            PembacaBiner r(data + offsetRekaman(mid), data + offKatalog);
+            uint32_t n = r.u32();
+            if (!r.cukup(n)) break;
+            int cmp = string::traits_type::compare(r.p, nim.data(), min<size_t>(n, nim.size()));
+            if (cmp == 0) cmp = n < nim.size() ? -1 : (n > nim.size() ? 1 : 0);
+            if (cmp == 0) return PembacaBiner(data + offsetRekaman(mid), data + offKatalog);
+            if (cmp < 0) lo = mid + 1; else hi = mid;
+        }
+        PembacaBiner gagal(data, data);
+        gagal.ok = false;
+        return gagal;
+    }
+
+    // All student records, in file order
+    PembacaBiner rekaman() const { return PembacaBiner(data + UKURAN_HEADER, data + offKatalog); }
+    PembacaBiner katalog() const { return PembacaBiner(data + offKatalog, data + offIndeks); }
+};
+
+// Streams a new snapshot to disk: student records first (remembering where each one starts),
+// then the catalog, then the NIM-sorted index, and the header last. Only a write buffer and
+// the (NIM, offset) pairs are kept in memory, so a million students never need to be loaded.
+class PenulisSnapshot {
+private:
+    int fd;
+    string buffer;
+    uint64_t offset;      // File offset of the next byte written
+    uint64_t offKatalog;
+    vector<pair<string, uint64_t>> indeks;
+    bool ok;
+
+    void flushBuffer() {
+        if (ok && !buffer.empty()) {
+            ok = tulisSemua(fd, buffer.data(), buffer.size());
+        }
+        buffer.clear();
+    }
+
+public:
+    PenulisSnapshot() : fd(-1), offset(0), offKatalog(0), ok(false) {}
+    PenulisSnapshot(const PenulisSnapshot&) = delete;
+    PenulisSnapshot& operator=(const PenulisSnapshot&) = delete;
+    ~PenulisSnapshot() {
+        if (fd >= 0) close(fd);
+    }
+
+    bool buka(const string& path) {
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        ok = fd >= 0;
+        buffer.assign(SnapshotTerpetakan::UKURAN_HEADER, '\0'); // Filled in by selesai()
+        offset = SnapshotTerpetakan::UKURAN_HEADER;
+        return ok;
+    }
+
+    void tulis(const char* data, size_t n) {
+        buffer.append(data, n);
+        offset += n;
+        if (buffer.size() >= (1 << 20)) flushBuffer();
+    }
+
+    // Appends one encoded student record
+    void tambahMahasiswa(const string& nim, const char* rekaman, size_t n) {
+        indeks.emplace_back(nim, offset);
+        tulis(rekaman, n);
+    }
+
+    void mulaiKatalog() { offKatalog = offset; }
+
+    // Writes the index and header and syncs the file; returns false if any write failed
+    bool selesai(uint64_t lsn) {
+        while (offset % 8 != 0) tulis("", 1);
+        uint64_t offIndeks = offset;
+        sort(indeks.begin(), indeks.end());
+        for (const auto& entry : indeks) {
+            tulis(reinterpret_cast<const char*>(&entry.second), 8);
+        }
+        flushBuffer();
+
+        PenulisBiner header;
+        header.data = "SSNAP006";
+        header.u64(lsn);
+        header.u64(indeks.size());
+        header.u64(offKatalog);
+        header.u64(offIndeks);
+        ok = ok && pwrite(fd, header.data.data(), header.data.size(), 0) == static_cast<ssize_t>(header.data.size());
+        ok = ok && fsync(fd) == 0;
+        ok = close(fd) == 0 && ok;
+        fd = -1;
+        return ok;
+    }
+};
+
+#endif
+
+// Read-only view of a whole file: memory-mapped on POSIX, read into memory on Windows
+class PetaBerkas {
+private:
+    const char* data;
+    size_t ukuran;
+#ifdef _WIN32
+    string isi;
+#endif
+
+public:
+    PetaBerkas() : data(nullptr), ukuran(0) {}
+    PetaBerkas(const PetaBerkas&) = delete;
+    PetaBerkas& operator=(const PetaBerkas&) = delete;
+    ~PetaBerkas() {
+#ifndef _WIN32
+        if (data != nullptr && ukuran > 0) munmap(const_cast<char*>(data), ukuran);
+#endif
+    }
+
+    bool buka(const string& path) {
+#ifdef _WIN32
+        ifstream file(path, ios::binary);
+        if (!file) return false;
+        isi.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        data = isi.data();
+        ukuran = isi.size();
+        return true;
+#else
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0;
+        ukuran = ok ? static_cast<size_t>(st.st_size) : 0;
+        if (ok && ukuran > 0) {
+            void* peta = mmap(nullptr, ukuran, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = peta != MAP_FAILED;
+            data = ok ? static_cast<const char*>(peta) : nullptr;
+            if (ok) madvise(peta, ukuran, MADV_SEQUENTIAL);
+        }
+        close(fd);
+        if (!ok) ukuran = 0;
+        return ok;
+#endif
+    }
+
+    const char* awal() const { return data; }
+    const char* akhir() const { return data + ukuran; }
+    size_t size() const { return ukuran; }
+};
+
+
+// ===============================================
+//           GLOBAL DATA AND POINTERS (DECLARED AFTER STRUCTS/CLASSES)
+// ===============================================
+
+// Global constants
+const string KAMPUS_CAKRAWALA = "Universitas Cakrawala";
+const char* const ANSI_CLEAR_HOME = "\x1b[H\x1b[2J\x1b[3J"; // Cursor home, clear screen and scrollback
+const int64_t LAMA_PINJAM_DETIK = 14 * 86400; // Loan period: two weeks
+const int64_t MAKS_HARI_JADWAL = 365; // Bookings can be moved up to a year ahead
+
+// Table layouts (column widths precomputed once)
+const TabelLayout TABEL_ANTREAN({{"No.", 5}, {"Nama Mahasiswa", 20}, {"Tanggal Daftar", 16}, {"Jadwal", 18}, {"Nama Dosen", 30}});
+const TabelLayout TABEL_BUKU({{"ID", 10}, {"Judul Buku", 50}, {"Status", 15}});
+const TabelLayout TABEL_REKOMENDASI({{"ID", 10}, {"Judul Buku", 50}, {"Dipinjam Bersama", 18}});
+const TabelLayout TABEL_DOSEN({{"ID Dosen", 15}, {"Nama Dosen", 25}, {"Mata Kuliah", 40}});
+const TabelLayout TABEL_PEMINJAMAN({{"Tanggal", 20}, {"Judul Buku", 50}});
+const TabelLayout TABEL_PINJAMAN_AKTIF({{"ID", 10}, {"Judul Buku", 50}, {"Jatuh Tempo", 15}, {"Status", 12}});
+const TabelLayout TABEL_PESANAN({{"ID", 10}, {"Judul Buku", 50}, {"Posisi Antrean", 15}});
+const TabelLayout TABEL_METRIK({{"Operasi", 22}, {"Jumlah", 9}, {"Rata-rata", 11}, {"p50", 10}, {"p90", 10}, {"p99", 10}, {"p99.9", 10}, {"Maks", 10}});
+const TabelLayout TABEL_AKTIVITAS({{"Tanggal", 20}, {"Riwayat Aktivitas", 60}});
+
+// Global container for Dosen data
+// 2. Queue - For Academic Consultation Queue (one queue per mentor, kept inside the registry)
+RegistriDosen dataDosen; // Key: interned mentor ID (also found by code or name), Value: Dosen + queue
+
+// 4. Hash Table - For Student Login (using map as simulation)
+map<string, Mahasiswa> dataMahasiswa; // Key: NIM, Value: Mahasiswa Object (students loaded so far with --data)
+mutex kunciDataMahasiswa; // Guards inserts into dataMahasiswa when students are loaded lazily from the snapshot
+
+// 5. Hash Indexes + Posting Lists - For Library Book List (title and ID indexes, per-mentor postings in title order)
+KatalogBuku daftarBuku;
+
+// 6. Graph - For Campus Navigation (weighted road graph with a contraction hierarchy)
+GrafJalan petaKampus; // Nodes: streets, stations and campus buildings; edges: road segments in meters
+CacheRute cacheRute(4096); // Routes between arbitrary places (routes to campus come from the graph's trees)
+
+// 7. Sparse Co-borrow Matrix - For Book Recommendations (a row per book with a maintained top-k)
+RekomendasiBuku rekomendasiBuku;
+
+// 8. Hierarchical Timing Wheels - For Book Loans (outstanding loans with their due dates)
+RegistriPinjaman pinjamanAktif;
+
+// 9. Pooled FIFO Queues - For Book Holds (a waitlist per borrowed book, handed over on return)
+AntreanPesanan antreanPesanan;
+
+// Per-operation counters and latency histograms (dumped on SIGUSR1 and, with --metrics, at exit)
+MetrikOperasi metrikOperasi;
+string berkasMetrik; // --metrics <file>: JSON dump target
+
+// Global variable to store current logged-in user
+Mahasiswa* currentUser = nullptr;
+
+#ifndef _WIN32
+// Persistence (only with --data <dir>): snapshot mapped at startup and the log of later events
+string direktoriData;
+SnapshotTerpetakan snapshotAktif;
+WriteAheadLog* walAktif = nullptr;
+#endif
+
+
+// ===============================================
+//           FORWARD DECLARATIONS OF FUNCTIONS
+// ===============================================
+
+// Utility functions
+void clearScreen();
+const string& judulAktivitas(const Aktivitas& a);
+string keteranganAktivitas(const Aktivitas& a);
+void pressEnterToContinue();
+void displayHeader();
+
+// UI functions (formerly in ConsoleUI)
+void displayLoginMenu();
+void displayMainMenu();
+void KonsultasiAkademikMenu();
+void PerpustakaanMenu();
+void RiwayatPeminjamanMenu();
+void RiwayatAktivitasMenu();
+void NavigasiKampusMenu();
+void MetrikOperasiMenu();
+
+// Outcome of a borrow request, reported by the service layer and rendered by the UI or batch mode
+enum class HasilPinjam { Berhasil, TidakTersedia, TidakDitemukan };
+
+// Outcome of a return request
+enum class HasilKembali { Berhasil, TidakDipinjam, TidakDitemukan };
+
+// Outcome of a hold request
+enum class HasilPesan { Berhasil, Tersedia, SudahMengantre, SedangDipinjam, TidakDitemukan };
+
+// Service-related helper functions (formerly in Services/*.h)
+void initializeData(); // Formerly in DataInitializer
+void initializeRoutes();
+void displayBooksTable(const BukuView& bukuList); // Formerly in LibraryService
+void borrowBook(const string& bookId, const string& dosenRujukan); // Formerly in LibraryService
+BukuView searchBooks(const string& keyword, const string& dosenRujukan); // Formerly in LibraryService
+BukuView filterAvailableBooks(const string& dosenRujukan); // Formerly in LibraryService
+BukuView booksByDosen(const string& dosenRujukan);
+void displayRekomendasi(const string& bookId);
+void returnBook(const string& bookId);
+bool displayPinjamanAktif();
+void reserveBook(const string& bookId, const string& dosenRujukan);
+
+// Service layer without console I/O (shared by the interactive menus and batch mode)
+Mahasiswa* cariMahasiswa(const string& nim);
+Mahasiswa* authenticate(const string& nim, const string& password);
+HasilPinjam pinjamBuku(Mahasiswa& mhs, const string& bookId, const string& dosenRujukan, size_t& slot);
+HasilKembali kembalikanBuku(Mahasiswa& mhs, const string& bookId, size_t& slot, RegistriPinjaman::Pinjaman& pinjaman, string& penerima);
+vector<pair<size_t, RegistriPinjaman::Pinjaman>> pinjamanBerjalan(Mahasiswa& mhs);
+HasilPesan pesanBuku(Mahasiswa& mhs, const string& bookId, const string& dosenRujukan, size_t& slot, size_t& posisi);
+vector<pair<size_t, size_t>> pesananBerjalan(Mahasiswa& mhs);
+void periksaJatuhTempo(int64_t waktu);
+uint32_t daftarKonsultasi(Mahasiswa& mhs, const string& idDosen);
+bool batalKonsultasi(Mahasiswa& mhs);
+uint32_t pindahKonsultasi(Mahasiswa& mhs, int64_t dari, int64_t& jadwal);
+uint32_t cariPosisiAntrean(Mahasiswa& mhs, size_t& posisi, int64_t& jadwal);
+vector<RekomendasiBuku::Skor> cariRekomendasi(const string& bookId, size_t k);
+bool cariRuteKampus(const string& asal, RuteJalan& rute);
+bool cariRute(const string& asal, const string& tujuan, RuteJalan& rute);
+
+// New/modified consultation service functions
+void registerConsultationLogic(string idDosen); // Simplified logic after ID is validated
+void moveConsultationLogic(const string& tanggalInput);
+bool displayDetailedConsultationQueue(const string& nim_mahasiswa); // Displays table and user's status
+
+void displayRoute(const string& stationName); // Formerly in CampusNavigationService
+
+// Metrics and JSON output
+string laporanMetrikTeks();
+string jsonMetrik();
+string jsonEscape(const string& text);
+
+// Persistence (no-ops unless started with --data)
+uint64_t catatWal(TipeWal tipe, const PenulisBiner& isi);
+void sinkronkanWal();
+void snapshotBilaPerlu();
+
+// ===============================================
+//           UTILITY FUNCTIONS
+// ===============================================
+
+// Starts a new frame with ANSI clear + home instead of spawning a shell for "clear"
+void clearScreen() {
+#ifdef _WIN32
+    cout.flush();
+    system("cls"); // Older Windows consoles do not interpret ANSI sequences
+#else
+    cout.flush(); // The previous screen goes out in one piece even if no read flushed it
+    cout << ANSI_CLEAR_HOME;
+#endif
+}
+
+// Title of the book a loan entry refers to
+const string& judulAktivitas(const Aktivitas& a) {
+    static const string TIDAK_DIKENAL = "-";
+    return a.ref < daftarBuku.size() ? daftarBuku.at(a.ref).judul : TIDAK_DIKENAL;
+}
+
+// Display text of a history entry, rendered from the catalog and the registry
+string keteranganAktivitas(const Aktivitas& a) {
+    switch (a.jenis) {
+        case JenisAktivitas::PinjamBuku:
+            return "Meminjam buku dengan judul \"" + judulAktivitas(a) + "\"";
+        case JenisAktivitas::DaftarKonsultasi:
+            return "Mendaftar konsultasi akademik dengan " + (a.ref < dataDosen.size() ? dataDosen.at(a.ref).nama : string("-"));
+        case JenisAktivitas::KembalikanBuku:
+            return "Mengembalikan buku dengan judul \"" + judulAktivitas(a) + "\"";
+        case JenisAktivitas::Terlambat:
+            return "Terlambat mengembalikan buku dengan judul \"" + judulAktivitas(a) + "\"";
+        case JenisAktivitas::PesanBuku:
+            return "Masuk antrean buku dengan judul \"" + judulAktivitas(a) + "\"";
+        case JenisAktivitas::TerimaPesanan:
+            return "Menerima buku antrean dengan judul \"" + judulAktivitas(a) + "\"";
+        case JenisAktivitas::BatalKonsultasi:
+            return "Membatalkan konsultasi akademik dengan " + (a.ref < dataDosen.size() ? dataDosen.at(a.ref).nama : string("-"));
+        case JenisAktivitas::PindahKonsultasi:
+            return "Memindahkan jadwal konsultasi akademik dengan " + (a.ref < dataDosen.size() ? dataDosen.at(a.ref).nama : string("-"));
+    }
+    return "";
+}
+
+void pressEnterToContinue() {
+    cout << "   Silahkan tekan 'Enter' untuk melanjutkan...";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer before getting new input
+    cin.get();
+}
+
+void displayHeader() {
+    cout << "============================================================================================\n";
+    cout << "  _____ ___ ___   ____  ____  ______   _____ ______  __ __  ___      ___  ____   ______ \n";
+    cout << " / ___/|   |   | /    ||    \\|      | / ___/|      ||  |  ||   \\    /  _]|    \\ |      |\n";
+    cout << "(   \\_ | _   _ ||  o  ||  D  )      |(   \\_ |      ||  |  ||    \\  /  [_ |  _  ||      |\n";
+    cout << " \\__  ||  \\_/  ||     ||    /|_|  |_| \\__  ||_|  |_||  |  ||  D  ||    _]|  |  ||_|  |_|\n";
+    cout << " /  \\ ||   |   ||  _  ||    \\  |  | __/  \\ |  |  |  |  :  ||     ||   [_ |  |  |  |  |  \n";
+    cout << " \\    ||   |   ||  |  ||  .  \\ |  ||  \\    |  |  |  |     ||     ||     ||  |  |  |  |  \n";
+    cout << "  \\___||___|___||__|__||__|\\_| |__||__|\\___|  |__|   \\__,_||_____||_____||__|__|  |__|  \n";
+    cout << "\n";
+    cout << "                                     CAKRAWALA UNIVERSITY                                    \n";
+    cout << "============================================================================================\n";
+    cout << "\n";
+}
+
+// ===============================================
+//           DATA INITIALIZATION FUNCTION
+// ===============================================
+
+void initializeData() {
+    // Data Mahasiswa (Hash Table)
+    dataMahasiswa["217403"] = Mahasiswa("217403", "15071999", "Aulia Putri");
+    dataMahasiswa["532618"] = Mahasiswa("532618", "03082002", "Rafi Akbar");
+    dataMahasiswa["894205"] = Mahasiswa("894205", "22121997", "Laras Wulan");
+    dataMahasiswa["670349"] = Mahasiswa("670349", "09052000", "Dito Pratama");
+    dataMahasiswa["356127"] = Mahasiswa("356127", "17111998", "Sinta Devi");
+
+    // Data Dosen (newly added)
+    const string dsn1 = dataDosen.at(dataDosen.add({"DSN1", "Idrus Madani", "Data Structures"})).nama;
+    const string dsn2 = dataDosen.at(dataDosen.add({"DSN2", "Dwi Wulan", "Algoritma dan Pemrograman"})).nama;
+
+    // Book Data (BST represented by std::set)
+    daftarBuku.insert({"A1B2", "Pengantar Python untuk Pemula", dsn1});
+    daftarBuku.insert({"C3D4", "Desain Web Responsif dengan HTML & CSS", dsn1});
+    daftarBuku.insert({"E5F6", "Struktur Data dan Algoritma dalam Java", dsn1});
+    daftarBuku.insert({"G7H8", "Prinsip Desain UI/UX Modern", dsn1});
+    daftarBuku.insert({"I9J0", "Pengembangan Aplikasi Android dengan Kotlin", dsn1});
+
+    daftarBuku.insert({"K1L2", "Seni Desain Grafis Digital", dsn2});
+    daftarBuku.insert({"M3N4", "Basis Data SQL untuk Pengembang", dsn2});
+    daftarBuku.insert({"O5P6", "Desain Interaksi Pengguna", dsn2});
+    daftarBuku.insert({"Q7R8", "Pengantar Machine Learning dengan Python", dsn2});
+    daftarBuku.insert({"S9T0", "Tipografi dalam Desain Grafis", dsn2});
+
+    initializeRoutes();
+}
+
+// Adds a station's way to campus to the road graph: the first step is the station (also known by
+// its short name), every later step is joined to the previous one by a segment of the given
+// length, and the last step is a campus building
+void tambahRuteStasiun(GrafJalan& peta, const string& stasiun, const vector<pair<string, uint32_t>>& langkah) {
+    if (langkah.empty()) return;
+    uint32_t sebelumnya = peta.tambahTitik(langkah[0].first);
+    peta.tambahAlias(stasiun, sebelumnya);
+    peta.tambahStasiun(stasiun, sebelumnya);
+    for (size_t i = 1; i < langkah.size(); i++) {
+        uint32_t titik = peta.tambahTitik(langkah[i].first);
+        peta.tambahJalan(sebelumnya, titik, langkah[i].second);
+        sebelumnya = titik;
+    }
+    peta.tandaiKampus(sebelumnya);
+}
+
+// Campus Navigation Roads (stations, streets and segment lengths in meters); not persisted, so
+// also loaded when starting from a snapshot
+void initializeRoutes() {
+    const string kampus = "Jl. Kemang Timur (" + KAMPUS_CAKRAWALA + ")";
+    tambahRuteStasiun(petaKampus, "Tebet", {
+        {"Tebet", 0},
+        {"Jl. Raya Kasablanka", 1500},
+        {"Jl. H. Rasuna Said", 2000},
+        {"Jl. Mampang Prapatan", 2500},
+        {"Jl. Kemang Utara", 1800},
+        {kampus, 1200}
+    });
+    tambahRuteStasiun(petaKampus, "Blok M", {
+        {"Blok M", 0},
+        {"Jl. Melawai Raya", 400},
+        {"Jl. Prapanca Raya", 1300},
+        {"Jl. Kemang Raya", 1500},
+        {"Jl. Kemang Selatan", 1100},
+        {kampus, 900}
+    });
+    tambahRuteStasiun(petaKampus, "Lb. Bulus", {
+        {"Lebak Bulus", 0},
+        {"Jl. RS. Fatmawati Raya", 1500},
+        {"Jl. TB Simatupang", 2200},
+        {"Jl. Ampera Raya", 2500},
+        {kampus, 2300}
+    });
+    tambahRuteStasiun(petaKampus, "Tanjung Barat", {
+        {"Tanjung Barat", 0},
+        {"Jl. TB Simatupang", 1600},
+        {"Jl. Ampera Raya", 2500},
+        {kampus, 2300}
+    });
+    tambahRuteStasiun(petaKampus, "Taman Mini", {
+        {"Taman Mini", 0},
+        {"Jl. Keong Mas", 1200},
+        {"Jl. Raya Mabes Hankam", 1500},
+        {"Jl. TB Simatupang", 4000},
+        {"Jl. Ampera Raya", 2500},
+        {kampus, 2300}
+    });
+    petaKampus.bangunIndeks();
+}
+
+// ===============================================
+//           BULK IMPORT (CSV)
+// ===============================================
+
+// Run with: ./smartstudent --import <dir> [--batch ...|--server ...]   (combines with --data)
+// Loads the files found in <dir> instead of the demo data. Each file has a header line, then one
+// record per line; fields may be "quoted" (with "" for a quote inside) to contain commas.
+//   dosen.csv      id,nama,mata_kuliah[,sesi[,hari]]  (sesi: "HH:MM*seats" entries separated by
+//                                                     spaces, hari: weekday digits 1 = Monday to
+//                                                     7 = Sunday; PolaJadwal's defaults if absent)
+//   mahasiswa.csv  nim,password,nama
+//   buku.csv       id,judul,dosen_id      (dosen_id is an id from dosen.csv)
+//   rute.csv       stasiun,langkah[,jarak_m]  (steps in order, each with the length of the segment
+//                                             leading to it, 1000 m if absent; the built-in roads
+//                                             if the file is absent)
+// Each file is memory-mapped, split at line boundaries into one chunk per core and the chunks are
+// parsed in parallel. Book rows name their mentor by ID, which is resolved once per run of equal
+// IDs to the name interned in the registry, and all books go to KatalogBuku::muatMassal at once.
+
+// Parses one CSV line into kolom, reusing its strings; returns the number of fields
+size_t parseBarisCsv(const char* p, const char* akhir, vector<string>& kolom) {
+    size_t n = 0;
+    while (true) {
+        if (kolom.size() <= n) kolom.emplace_back();
+        string& field = kolom[n++];
+        field.clear();
+        if (p < akhir && *p == '"') {
+            p++;
+            while (p < akhir) {
+                const char* kutip = static_cast<const char*>(memchr(p, '"', static_cast<size_t>(akhir - p)));
+                if (kutip == nullptr) {
+                    field.append(p, akhir);
+                    p = akhir;
+                    break;
+                }
+                field.append(p, kutip);
+                p = kutip + 1;
+                if (p < akhir && *p == '"') {
+                    field += '"';
+                    p++;
+                } else {
+                    break;
+                }
+            }
+            while (p < akhir && *p != ',') p++; // Text after the closing quote is ignored
+        } else {
+            const char* koma = static_cast<const char*>(memchr(p, ',', static_cast<size_t>(akhir - p)));
+            const char* ujung = koma != nullptr ? koma : akhir;
+            field.assign(p, ujung);
+            p = ujung;
+        }
+        if (p >= akhir) return n;
+        p++; // Past the comma
+    }
+}
+
+// Number of chunks a file of this size is split into (one per core, at least 64 KiB each)
+size_t jumlahChunkCsv(const PetaBerkas& berkas) {
+    return max<size_t>(1, min<size_t>(thread::hardware_concurrency(), berkas.size() / 65536 + 1));
+}
+
+// Parses every record after the header line, chunk t on its own thread. baris(t, kolom, n) gets
+// the n fields of each non-empty line; within a chunk lines arrive in file order.
+template <typename F>
+void parseCsvParalel(const PetaBerkas& berkas, size_t jumlahChunk, F baris) {
+    const char* awal = berkas.awal();
+    const char* akhir = berkas.akhir();
+    const char* header = awal == akhir ? nullptr : static_cast<const char*>(memchr(awal, '\n', berkas.size()));
+    awal = header != nullptr ? header + 1 : akhir;
+
+    vector<const char*> batas(jumlahChunk + 1, akhir);
+    batas[0] = awal;
+    for (size_t t = 1; t < jumlahChunk; t++) {
+        const char* p = max(batas[t - 1], awal + (akhir - awal) * static_cast<ptrdiff_t>(t) / static_cast<ptrdiff_t>(jumlahChunk));
+        const char* nl = p == akhir ? nullptr : static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(akhir - p)));
+        batas[t] = nl != nullptr ? nl + 1 : akhir;
+    }
+
+    auto parseChunk = [&](size_t t) {
+        vector<string> kolom;
+        const char* p = batas[t];
+        while (p < batas[t + 1]) {
+            const char* nl = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(batas[t + 1] - p)));
+            const char* ujung = nl != nullptr ? nl : batas[t + 1];
+            const char* isi = ujung;
+            if (isi > p && isi[-1] == '\r') isi--;
+            if (isi > p) {
+                baris(t, kolom, parseBarisCsv(p, isi, kolom));
+            }
+            p = nl != nullptr ? nl + 1 : batas[t + 1];
+        }
+    };
+    vector<thread> threads;
+    for (size_t t = 1; t < jumlahChunk; t++) {
+        threads.emplace_back(parseChunk, t);
+    }
+    parseChunk(0);
+    for (thread& th : threads) th.join();
+}
+
+// Each importer returns the number of records added and counts rejected rows in `ditolak`
+// (too few fields, unknown mentor, or a duplicate ID/NIM/title).
+
+// Parses a mentor's week from the dosen.csv columns, e.g. "09:00*4 13:30*2" and "135".
+// False for a malformed or repeated session, or a week without a single seat.
+bool parsePolaJadwal(const string& sesi, const string& hari, PolaJadwal& pola) {
+    if (!sesi.empty()) {
+        pola.sesi.clear();
+        istringstream in(sesi);
+        string entri;
+        while (in >> entri) {
+            int jam = 0, menit = 0, kapasitas = 0;
+            char lebih;
+            if (sscanf(entri.c_str(), "%d:%d*%d%c", &jam, &menit, &kapasitas, &lebih) != 3 || jam < 0 || jam > 23 ||
+                menit < 0 || menit > 59 || kapasitas < 0 || kapasitas > 65535) {
+                return false;
+            }
+            pola.sesi.push_back({static_cast<uint16_t>(jam * 60 + menit), static_cast<uint16_t>(kapasitas)});
+        }
+        sort(pola.sesi.begin(), pola.sesi.end(), [](const PolaJadwal::Sesi& a, const PolaJadwal::Sesi& b) { return a.menit < b.menit; });
+        for (size_t i = 1; i < pola.sesi.size(); i++) {
+            if (pola.sesi[i].menit == pola.sesi[i - 1].menit) return false;
+        }
+    }
+    if (!hari.empty()) {
+        pola.hari = 0;
+        for (char c : hari) {
+            if (c < '1' || c > '7') return false;
+            pola.hari |= static_cast<uint8_t>(1 << (c - '1'));
+        }
+    }
+    return pola.kapasitasMingguan() > 0;
+}
+
+size_t imporDosen(const PetaBerkas& berkas, RegistriDosen& registri, size_t& ditolak) {
+    size_t jumlahChunk = jumlahChunkCsv(berkas);
+    vector<vector<pair<Dosen, PolaJadwal>>> hasil(jumlahChunk);
+    vector<size_t> tolak(jumlahChunk, 0);
+    parseCsvParalel(berkas, jumlahChunk, [&](size_t t, vector<string>& kolom, size_t n) {
+        PolaJadwal pola;
+        if (n < 3 || !parsePolaJadwal(n > 3 ? kolom[3] : string(), n > 4 ? kolom[4] : string(), pola)) {
+            tolak[t]++;
+            return;
+        }
+        hasil[t].push_back({{kolom[0], kolom[1], kolom[2]}, std::move(pola)});
+    });
+
+    size_t awal = registri.size(), jumlahBaris = 0;
+    for (size_t t = 0; t < jumlahChunk; t++) {
+        ditolak += tolak[t];
+        for (const pair<Dosen, PolaJadwal>& d : hasil[t]) {
+            registri.add(d.first, d.second); // A repeated ID keeps the first mentor
+        }
+        jumlahBaris += hasil[t].size();
+    }
+    size_t dimuat = registri.size() - awal;
+    ditolak += jumlahBaris - dimuat;
+    return dimuat;
+}
+
+size_t imporMahasiswa(const PetaBerkas& berkas, map<string, Mahasiswa>& tujuan, size_t& ditolak) {
+    size_t jumlahChunk = jumlahChunkCsv(berkas);
+    vector<vector<Mahasiswa>> hasil(jumlahChunk);
+    vector<size_t> tolak(jumlahChunk, 0);
+    parseCsvParalel(berkas, jumlahChunk, [&](size_t t, vector<string>& kolom, size_t n) {
+        if (n < 3) {
+            tolak[t]++;
+            return;
+        }
+        hasil[t].emplace_back(kolom[0], kolom[1], kolom[2]);
+    });
+
+    // Inserting in NIM order lets every insert use the end of the tree as its hint
+    vector<Mahasiswa*> urut;
+    for (size_t t = 0; t < jumlahChunk; t++) {
+        ditolak += tolak[t];
+        for (Mahasiswa& mhs : hasil[t]) urut.push_back(&mhs);
+    }
+    stable_sort(urut.begin(), urut.end(), [](const Mahasiswa* a, const Mahasiswa* b) { return a->nim < b->nim; });
+    size_t awal = tujuan.size();
+    for (Mahasiswa* mhs : urut) {
+        tujuan.emplace_hint(tujuan.end(), mhs->nim, std::move(*mhs)); // First row of a repeated NIM wins
+    }
+    ditolak += urut.size() - (tujuan.size() - awal);
+    return tujuan.size() - awal;
+}
+
+size_t imporBuku(const PetaBerkas& berkas, const RegistriDosen& registri, KatalogBuku& katalog, size_t& ditolak) {
+    size_t jumlahChunk = jumlahChunkCsv(berkas);
+    vector<vector<Buku>> hasil(jumlahChunk);
+    vector<size_t> tolak(jumlahChunk, 0);
+    vector<string> kodeTerakhir(jumlahChunk);                 // Mentor ID of the chunk's previous row
+    vector<const string*> namaTerakhir(jumlahChunk, nullptr); // Its interned name (nullptr: unknown)
+    parseCsvParalel(berkas, jumlahChunk, [&](size_t t, vector<string>& kolom, size_t n) {
+        if (n < 3) {
+            tolak[t]++;
+            return;
+        }
+        if (kolom[2] != kodeTerakhir[t] || namaTerakhir[t] == nullptr) {
+            uint32_t id = registri.findByKode(kolom[2]);
+            namaTerakhir[t] = id == RegistriDosen::NOT_FOUND ? nullptr : &registri.at(id).nama;
+            kodeTerakhir[t] = kolom[2];
+        }
+        if (namaTerakhir[t] == nullptr) {
+            tolak[t]++;
+            return;
+        }
+        hasil[t].push_back({kolom[0], std::move(kolom[1]), *namaTerakhir[t]});
+    });
+
+    vector<Buku> semua;
+    if (jumlahChunk == 1) {
+        semua = std::move(hasil[0]);
+    } else {
+        size_t total = 0;
+        for (const vector<Buku>& chunk : hasil) total += chunk.size();
+        semua.reserve(total);
+        for (vector<Buku>& chunk : hasil) {
+            move(chunk.begin(), chunk.end(), back_inserter(semua));
+            vector<Buku>().swap(chunk);
+        }
+    }
+    for (size_t t = 0; t < jumlahChunk; t++) ditolak += tolak[t];
+    size_t jumlah = semua.size();
+    size_t dimuat = katalog.muatMassal(std::move(semua));
+    ditolak += jumlah - dimuat;
+    return dimuat;
+}
+
+// Each station's steps become a chain of road segments ending at a campus building. Steps that
+// would take the graph past GrafJalan::BATAS_PANJANG meters in all are rejected, so no route
+// length can overflow.
+size_t imporRute(const PetaBerkas& berkas, GrafJalan& peta, size_t& ditolak) {
+    const uint32_t JARAK_BAKU = 1000;
+    struct BarisRute {
+        string stasiun, langkah;
+        uint32_t meter;
+    };
+    size_t jumlahChunk = jumlahChunkCsv(berkas);
+    vector<vector<BarisRute>> hasil(jumlahChunk);
+    vector<size_t> tolak(jumlahChunk, 0);
+    parseCsvParalel(berkas, jumlahChunk, [&](size_t t, vector<string>& kolom, size_t n) {
+        char* akhir = nullptr;
+        unsigned long meter = n >= 3 && !kolom[2].empty() ? strtoul(kolom[2].c_str(), &akhir, 10) : JARAK_BAKU;
+        if (n < 2 || (akhir != nullptr && *akhir != '\0') || meter > 100000000) {
+            tolak[t]++;
+            return;
+        }
+        hasil[t].push_back({kolom[0], kolom[1], static_cast<uint32_t>(meter)});
+    });
+
+    vector<string> urutanStasiun; // First appearance order, which is the menu order
+    unordered_map<string, vector<pair<string, uint32_t>>> langkahPerStasiun;
+    size_t dimuat = 0;
+    uint64_t panjang = peta.panjangTotal();
+    for (size_t t = 0; t < jumlahChunk; t++) { // Chunks in file order keep the steps in order
+        ditolak += tolak[t];
+        for (BarisRute& baris : hasil[t]) {
+            if (panjang + baris.meter > GrafJalan::BATAS_PANJANG) {
+                ditolak++;
+                continue;
+            }
+            panjang += baris.meter;
+            vector<pair<string, uint32_t>>& langkah = langkahPerStasiun[baris.stasiun];
+            if (langkah.empty()) urutanStasiun.push_back(baris.stasiun);
+            langkah.push_back({std::move(baris.langkah), baris.meter});
+            dimuat++;
+        }
+    }
+    for (const string& stasiun : urutanStasiun) tambahRuteStasiun(peta, stasiun, langkahPerStasiun[stasiun]);
+    peta.bangunIndeks();
+    return dimuat;
+}
+
+// Loads every CSV file present in dir into the global data; false if there is none
+bool imporCsv(const string& dir) {
+    const char* NAMA_BERKAS[] = {"dosen.csv", "mahasiswa.csv", "buku.csv", "rute.csv"}; // Mentors first: books refer to them
+    bool adaBerkas = false;
+    bool adaRute = false;
+    for (size_t i = 0; i < 4; i++) {
+        const char* nama = NAMA_BERKAS[i];
+        PetaBerkas berkas;
+        if (!berkas.buka(dir + "/" + nama)) continue;
+        adaBerkas = true;
+        size_t dimuat = 0, ditolak = 0;
+        auto start = chrono::steady_clock::now();
+        switch (i) {
+            case 0: dimuat = imporDosen(berkas, dataDosen, ditolak); break;
+            case 1: dimuat = imporMahasiswa(berkas, dataMahasiswa, ditolak); break;
+            case 2: dimuat = imporBuku(berkas, dataDosen, daftarBuku, ditolak); break;
+            case 3:
+                dimuat = imporRute(berkas, petaKampus, ditolak);
+                cacheRute.kosongkan();
+                adaRute = true;
+                break;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cerr << "Impor " << nama << ": " << dimuat << " dimuat, " << ditolak << " ditolak (" << ms << " ms)\n";
+    }
+    if (!adaBerkas) {
+        cerr << "Tidak ada berkas CSV untuk diimpor di " << dir << "\n";
+        return false;
+    }
+    if (!adaRute) {
+        initializeRoutes();
+    }
+    return true;
+}
+
+// Startup data without a snapshot: the CSV files if an import directory was given, else the demo data
+bool muatDataAwal(const string& direktoriImpor) {
+    if (direktoriImpor.empty()) {
+        initializeData();
+        return true;
+    }
+    return imporCsv(direktoriImpor);
+}
+
+// ===============================================
+//           AUTHENTICATION SERVICE FUNCTIONS
+// ===============================================
+
+// Returns the student if NIM and password match, nullptr otherwise
+Mahasiswa* authenticate(const string& nim, const string& password) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Login);
+    Mahasiswa* mhs = cariMahasiswa(nim);
+    if (mhs != nullptr && mhs->password == password) {
+        return mhs;
+    }
+    return nullptr;
+}
+
+void loginUser(string nim, string password) {
+    currentUser = authenticate(nim, password); // Null on failed login
+}
+
+// ===============================================
+//           CONSULTATION SERVICE FUNCTIONS
+// ===============================================
+
+// Helper function to display a specific queue table
+void displayQueueTableInternal(const JadwalKonsultasi& antrean) { // Iterates in place, no copy
+    string out;
+    TABEL_ANTREAN.appendHeader(out);
+
+    int no_display = 1;
+    int64_t jadwalSebelumnya = JadwalKonsultasi::TIDAK_ADA;
+    string teksJadwal;
+    antrean.untukSetiap([&](const Konsultasi& k) {
+        if (k.jadwal != jadwalSebelumnya) { // Rows come in session order: format each session once
+            jadwalSebelumnya = k.jadwal;
+            teksJadwal = LayananWaktu::tanggalJam(k.jadwal);
+        }
+        TABEL_ANTREAN.appendRow(out, {to_string(no_display++), k.nama_mahasiswa, k.tanggal_daftar, teksJadwal, k.nama_dosen});
+    });
+    out += '\n';
+    cout << out;
+}
+
+// Books the student into the mentor's earliest free session and records the activity. Shared
+// by live registrations and WAL replay, so both produce exactly the same state. False (nothing
+// changed, an earlier booking is kept) if the mentor holds no sessions.
+bool terapkanDaftar(Mahasiswa& mhs, uint32_t dosenId, int64_t waktu) {
+    const string& namaDosen = dataDosen.at(dosenId).nama;
+    Konsultasi newKonsultasi;
+    newKonsultasi.nama_mahasiswa = mhs.nama;
+    newKonsultasi.nim_mahasiswa = mhs.nim;
+    newKonsultasi.tanggal_daftar = LayananWaktu::tanggal(waktu);
+    newKonsultasi.nama_dosen = namaDosen;
+
+    if (dataDosen.daftar(dosenId, newKonsultasi, waktu) == JadwalKonsultasi::TIDAK_ADA) {
+        return false; // Imported weeks always have seats (see parsePolaJadwal)
+    }
+
+    lock_guard<mutex> lock(mhs.kunci.m);
+    mhs.riwayat_aktivitas.add({waktu, dosenId, JenisAktivitas::DaftarKonsultasi});
+    mhs.sudah_daftar_konsultasi = true;
+    mhs.dosen_konsultasi_terdaftar = namaDosen;
+    return true;
+}
+
+// Books the student with the mentor and records the activity (no console output)
+// Returns the mentor ID, or RegistriDosen::NOT_FOUND if the Dosen ID does not exist or the
+// mentor holds no sessions
+uint32_t daftarKonsultasi(Mahasiswa& mhs, const string& idDosen) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::DaftarKonsultasi);
+    uint32_t dosenId = dataDosen.findByKode(idDosen);
+    if (dosenId == RegistriDosen::NOT_FOUND) {
+        return dosenId;
+    }
+    int64_t waktu = LayananWaktu::sekarang();
+    if (!terapkanDaftar(mhs, dosenId, waktu)) {
+        return RegistriDosen::NOT_FOUND;
+    }
+
+    PenulisBiner event;
+    event.str(mhs.nim);
+    event.str(idDosen);
+    event.u64(static_cast<uint64_t>(waktu));
+    catatWal(TipeWal::Daftar, event);
+    return dosenId;
+}
+
+// Cancels the student's booking and records the activity; the student has to register again
+// before using the library (live cancellations and WAL replay). Returns the mentor, NOT_FOUND if
+// the student had no booking.
+uint32_t terapkanBatal(Mahasiswa& mhs, int64_t waktu) {
+    uint32_t dosenId = dataDosen.batal(mhs.nim);
+    if (dosenId == RegistriDosen::NOT_FOUND) return dosenId;
+    lock_guard<mutex> lock(mhs.kunci.m);
+    mhs.riwayat_aktivitas.add({waktu, dosenId, JenisAktivitas::BatalKonsultasi});
+    mhs.sudah_daftar_konsultasi = false;
+    mhs.dosen_konsultasi_terdaftar.clear();
+    return dosenId;
+}
+
+// Cancels the student's consultation booking and logs it (no console output); false if none
+bool batalKonsultasi(Mahasiswa& mhs) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::BatalKonsultasi);
+    int64_t waktu = LayananWaktu::sekarang();
+    if (terapkanBatal(mhs, waktu) == RegistriDosen::NOT_FOUND) return false;
+
+    PenulisBiner event;
+    event.str(mhs.nim);
+    event.u64(static_cast<uint64_t>(waktu));
+    catatWal(TipeWal::Batal, event);
+    return true;
+}
+
+// Moves the student's booking to the first session after `dari` with a seat left and records
+// the activity (live moves and WAL replay). Returns the mentor, NOT_FOUND if there is no booking.
+uint32_t terapkanPindah(Mahasiswa& mhs, int64_t dari, int64_t waktu, int64_t& jadwal) {
+    uint32_t dosenId = dataDosen.pindah(mhs.nim, dari, jadwal);
+    if (dosenId == RegistriDosen::NOT_FOUND) return dosenId;
+    lock_guard<mutex> lock(mhs.kunci.m);
+    mhs.riwayat_aktivitas.add({waktu, dosenId, JenisAktivitas::PindahKonsultasi});
+    return dosenId;
+}
+
+// Moves the student's booking to the first free session after `dari` (never one that has
+// started) and logs it (no console output). Returns the mentor (RegistriDosen::NOT_FOUND if the
+// student has no booking); `jadwal` receives the new session's start.
+uint32_t pindahKonsultasi(Mahasiswa& mhs, int64_t dari, int64_t& jadwal) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::PindahKonsultasi);
+    int64_t waktu = LayananWaktu::sekarang();
+    dari = max(dari, waktu);
+    uint32_t dosenId = terapkanPindah(mhs, dari, waktu, jadwal);
+    if (dosenId == RegistriDosen::NOT_FOUND) return dosenId;
+
+    PenulisBiner event;
+    event.str(mhs.nim);
+    event.u64(static_cast<uint64_t>(dari));
+    event.u64(static_cast<uint64_t>(waktu));
+    catatWal(TipeWal::Pindah, event);
+    return dosenId;
+}
+
+// Finds the schedule the student is in (RegistriDosen::NOT_FOUND if none), their 1-based position
+// and the start of their session. Also marks the student as registered if they are booked but
+// the flag was not set yet.
+uint32_t cariPosisiAntrean(Mahasiswa& mhs, size_t& posisi, int64_t& jadwal) {
+    // O(log n): the registry knows which mentor's schedule the student is in, and the schedule's
+    // tree counts the bookings ahead of them
+    uint32_t dosenId = dataDosen.cariAntrean(mhs.nim, posisi, jadwal);
+    if (dosenId != RegistriDosen::NOT_FOUND) {
+        lock_guard<mutex> lock(mhs.kunci.m);
+        if (!mhs.sudah_daftar_konsultasi) {
+            mhs.sudah_daftar_konsultasi = true;
+            mhs.dosen_konsultasi_terdaftar = dataDosen.at(dosenId).nama;
+        }
+    }
+    return dosenId;
+}
+
+// Function to register consultation based on Dosen ID
+void registerConsultationLogic(string idDosen) {
+    uint32_t dosenId = daftarKonsultasi(*currentUser, idDosen);
+    if (dosenId != RegistriDosen::NOT_FOUND) {
+        sinkronkanWal(); // Confirm only once the registration is durable
+        cout << "\n   " << currentUser->nama << " telah berhasil mendaftarkan konsultasi dengan " << dataDosen.at(dosenId).nama << ".\n";
+        size_t posisi = 0;
+        int64_t jadwal = 0;
+        if (cariPosisiAntrean(*currentUser, posisi, jadwal) != RegistriDosen::NOT_FOUND) {
+            cout << "   Jadwal konsultasi: " << LayananWaktu::tanggal(jadwal) << " pukul " << LayananWaktu::jam(jadwal) << ".\n";
+        }
+    } else {
+        cout << "\n   ID Dosen tidak ditemukan. Pendaftaran gagal.\n";
+    }
+    pressEnterToContinue();
+}
+
+// Moves the current student's booking to the first free session on or after the date typed
+// (dd-mm-yyyy), or after their current session if the input is empty
+void moveConsultationLogic(const string& tanggalInput) {
+    size_t posisi = 0;
+    int64_t jadwal = 0;
+    int64_t dari = LayananWaktu::dariTanggal(tanggalInput);
+    if (tanggalInput.empty() && cariPosisiAntrean(*currentUser, posisi, jadwal) != RegistriDosen::NOT_FOUND) {
+        dari = jadwal;
+    }
+    if (dari < 0 || dari > LayananWaktu::sekarang() + MAKS_HARI_JADWAL * 86400) {
+        cout << "\n   Tanggal tidak valid. Jadwal tidak diubah.\n";
+    } else if (pindahKonsultasi(*currentUser, dari, jadwal) == RegistriDosen::NOT_FOUND) {
+        cout << "\n   Anda belum terdaftar dalam antrean konsultasi.\n";
+    } else {
+        sinkronkanWal(); // Confirm only once the move is durable
+        cout << "\n   Jadwal konsultasi dipindahkan ke " << LayananWaktu::tanggal(jadwal) << " pukul " << LayananWaktu::jam(jadwal) << ".\n";
+    }
+    pressEnterToContinue();
+}
+
+// Displays queue for the user's chosen mentor or general message if not registered
+// Returns true if the student holds a booking
+bool displayDetailedConsultationQueue(const string& nim_mahasiswa) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::LihatAntrean);
+    size_t userQueueNumber = 0;
+    int64_t jadwal = 0;
+    Mahasiswa* mhs = cariMahasiswa(nim_mahasiswa);
+    uint32_t dosenId = mhs == nullptr ? RegistriDosen::NOT_FOUND : cariPosisiAntrean(*mhs, userQueueNumber, jadwal);
+    bool userInQueue = dosenId != RegistriDosen::NOT_FOUND;
+    string dosenTerdaftar = userInQueue ? dataDosen.at(dosenId).nama : "";
+
+    if (userInQueue) {
+        dataDosen.bacaAntrean(dosenId, displayQueueTableInternal);
+
+        cout << "   Anda terdaftar dalam antrean : [" << userQueueNumber << "]\n";
+        string sesi = LayananWaktu::tanggalJam(jadwal); // Same text as the table row
+        cout << "   Konsultasi dengan " << dosenTerdaftar << " pada " << sesi.substr(0, 10) << " pukul " << sesi.substr(11) << ".\n";
+        cout << "\n";
+        // pressEnterToContinue() will be called by ConsoleUI after this function returns
+    } else {
+        // This message is only shown if the user is NOT in queue and no other queue is displayed
+        // No table here, as per new requirement: "Belum ada antrean yang terdaftar." is handled in ConsoleUI if option 2 is chosen.
+    }
+    return userInQueue;
+}
+
+// ===============================================
+//           LIBRARY SERVICE FUNCTIONS
+// ===============================================
+
+void displayBooksTable(const BukuView& bukuList) {
+    string out;
+    TABEL_BUKU.appendHeader(out);
+    if (bukuList.empty()) {
+        out += "Tidak ada buku untuk ditampilkan.\n";
+    } else {
+        for (size_t slot : bukuList) {
+            const Buku& buku = daftarBuku.at(slot);
+            TABEL_BUKU.appendRow(out, {buku.id, buku.judul, daftarBuku.isTersedia(slot) ? "Tersedia" : "Tidak Tersedia"});
+        }
+    }
+    out += '\n';
+    cout << out;
+}
+
+// All books referenced by a mentor, in title order
+BukuView booksByDosen(const string& dosenRujukan) {
+    return {daftarBuku.slotsByDosen(dosenRujukan)};
+}
+
+// Records a borrowed book in the student's loan and activity history, opens the loan with its due
+// date and counts it against the student's recent loans for recommendations (live borrows, hold
+// hand-offs and WAL replay). `jenisAktivitas` is the kind shown in the activity history.
+void terapkanPinjam(Mahasiswa& mhs, size_t slot, int64_t waktu, JenisAktivitas jenisAktivitas = JenisAktivitas::PinjamBuku) {
+    pinjamanAktif.catat(static_cast<uint32_t>(slot), mhs.nim, waktu, waktu + LAMA_PINJAM_DETIK);
+    Aktivitas pinjam{waktu, static_cast<uint32_t>(slot), JenisAktivitas::PinjamBuku};
+    vector<uint32_t> sebelumnya;
+    {
+        lock_guard<mutex> lock(mhs.kunci.m);
+        mhs.riwayat_peminjaman.add(pinjam);
+        mhs.riwayat_aktivitas.add({waktu, pinjam.ref, jenisAktivitas});
+        sebelumnya = mhs.pinjaman_terakhir;
+        if (!RekomendasiBuku::geserJendela(mhs.pinjaman_terakhir, pinjam.ref)) sebelumnya.clear(); // Already counted
+    }
+    rekomendasiBuku.catat(pinjam.ref, sebelumnya);
+}
+
+// Books most often borrowed by the students who borrowed this one; empty if the ID is unknown
+vector<RekomendasiBuku::Skor> cariRekomendasi(const string& bookId, size_t k) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Rekomendasi);
+    size_t slot = daftarBuku.findSlotById(bookId);
+    if (slot == KatalogBuku::NOT_FOUND) return {};
+    return rekomendasiBuku.teratas(static_cast<uint32_t>(slot), k);
+}
+
+// Borrows a book for the student and records it in their history (no console output).
+// `slot` receives the book's catalog slot when the ID is found.
+HasilPinjam pinjamBuku(Mahasiswa& mhs, const string& bookId, const string& dosenRujukan, size_t& slot) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Pinjam);
+    slot = daftarBuku.findSlotById(bookId);
+    if (slot == KatalogBuku::NOT_FOUND || daftarBuku.at(slot).dosen_referensi != dosenRujukan) {
+        return HasilPinjam::TidakDitemukan;
+    }
+    if (!daftarBuku.pinjam(slot)) { // Only the availability bit changes; the catalog itself is untouched
+        return HasilPinjam::TidakTersedia;
+    }
+    int64_t waktu = LayananWaktu::sekarang();
+    terapkanPinjam(mhs, slot, waktu);
+
+    PenulisBiner event;
+    event.str(mhs.nim);
+    event.str(bookId);
+    event.u64(static_cast<uint64_t>(waktu));
+    catatWal(TipeWal::Pinjam, event);
+    return HasilPinjam::Berhasil;
+}
+
+void borrowBook(const string& bookId, const string& dosenRujukan) {
+    size_t slot = KatalogBuku::NOT_FOUND;
+    switch (pinjamBuku(*currentUser, bookId, dosenRujukan, slot)) {
+        case HasilPinjam::Berhasil: {
+            sinkronkanWal(); // Confirm only once the loan is durable
+            cout << "\n   Buku \"" << daftarBuku.at(slot).judul << "\" telah berhasil dipinjam.\n";
+            RegistriPinjaman::Pinjaman pinjaman;
+            if (pinjamanAktif.cari(static_cast<uint32_t>(slot), pinjaman)) {
+                cout << "   Harap dikembalikan paling lambat " << LayananWaktu::tanggal(pinjaman.jatuhTempo) << ".\n";
+            }
+            vector<RekomendasiBuku::Skor> saran = cariRekomendasi(bookId, 3);
+            if (!saran.empty()) {
+                cout << "\n   Mahasiswa yang meminjam buku ini juga meminjam:\n";
+                for (const RekomendasiBuku::Skor& skor : saran) {
+                    cout << "   - " << daftarBuku.at(skor.slot).judul << '\n';
+                }
+            }
+            break;
+        }
+        case HasilPinjam::TidakTersedia: {
+            cout << "\n   Buku \"" << daftarBuku.at(slot).judul << "\" tidak tersedia (sudah dipinjam).\n";
+            cout << "   Masuk antrean untuk buku ini? (y/n) : ";
+            string jawaban;
+            getline(cin, jawaban);
+            if (jawaban == "y" || jawaban == "Y") reserveBook(bookId, dosenRujukan);
+            break;
+        }
+        case HasilPinjam::TidakDitemukan:
+            cout << "\nID Buku tidak ditemukan atau bukan rujukan dosen ini.\n";
+            break;
+    }
+    pressEnterToContinue();
+}
+
+void reserveBook(const string& bookId, const string& dosenRujukan) {
+    size_t slot = KatalogBuku::NOT_FOUND;
+    size_t posisi = 0;
+    switch (pesanBuku(*currentUser, bookId, dosenRujukan, slot, posisi)) {
+        case HasilPesan::Berhasil:
+            sinkronkanWal(); // Confirm only once the hold is durable
+            cout << "\n   Anda masuk antrean buku \"" << daftarBuku.at(slot).judul << "\" di posisi " << posisi << ".\n";
+            cout << "   Buku akan langsung dipinjamkan kepada Anda saat tiba giliran Anda.\n";
+            break;
+        case HasilPesan::SudahMengantre:
+            cout << "\n   Anda sudah berada dalam antrean buku ini di posisi " << posisi << ".\n";
+            break;
+        case HasilPesan::SedangDipinjam:
+            cout << "\n   Buku ini sedang Anda pinjam.\n";
+            break;
+        case HasilPesan::Tersedia:
+            cout << "\n   Buku sudah tersedia kembali, silakan langsung dipinjam.\n";
+            break;
+        case HasilPesan::TidakDitemukan:
+            cout << "\nID Buku tidak ditemukan atau bukan rujukan dosen ini.\n";
+            break;
+    }
+}
+
+// Hands a returned book straight to the first student waiting for it (a loan from `waktu`), or
+// puts it back on the shelf if nobody is. Returns the receiving student's NIM, empty if none.
+string serahkanBuku(size_t slot, int64_t waktu) {
+    AntreanPesanan::Pesanan pesanan;
+    while (antreanPesanan.serahkanAtauKembalikan(static_cast<uint32_t>(slot), daftarBuku, pesanan)) {
+        Mahasiswa* penerima = cariMahasiswa(pesanan.nim);
+        if (penerima != nullptr) {
+            {
+                lock_guard<mutex> lock(penerima->kunci.m);
+                vector<uint32_t>& ditunggu = penerima->pesanan_aktif; // Lacks the slot if just decoded
+                ditunggu.erase(remove(ditunggu.begin(), ditunggu.end(), static_cast<uint32_t>(slot)), ditunggu.end());
+            }
+            terapkanPinjam(*penerima, slot, waktu, JenisAktivitas::TerimaPesanan);
+            return penerima->nim;
+        }
+    }
+    return "";
+}
+
+// Ends a loan, records the return in the student's activity history and hands the book to the
+// next hold (live returns and WAL replay). False if the student does not hold the book;
+// `penerima` receives the NIM the book went to, empty if it was shelved.
+bool terapkanKembali(Mahasiswa& mhs, size_t slot, int64_t waktu, RegistriPinjaman::Pinjaman& pinjaman, string& penerima) {
+    if (!pinjamanAktif.akhiri(static_cast<uint32_t>(slot), mhs.nim, pinjaman)) return false;
+    {
+        lock_guard<mutex> lock(mhs.kunci.m);
+        mhs.riwayat_aktivitas.add({waktu, static_cast<uint32_t>(slot), JenisAktivitas::KembalikanBuku});
+    }
+    penerima = serahkanBuku(slot, waktu);
+    return true;
+}
+
+// Returns a book the student holds and logs it (no console output). `slot` receives the book's
+// catalog slot when the ID is found, `pinjaman` the loan that ended and `penerima` the NIM of the
+// student the book was handed to (empty if none was waiting).
+HasilKembali kembalikanBuku(Mahasiswa& mhs, const string& bookId, size_t& slot, RegistriPinjaman::Pinjaman& pinjaman, string& penerima) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Kembali);
+    slot = daftarBuku.findSlotById(bookId);
+    if (slot == KatalogBuku::NOT_FOUND) {
+        return HasilKembali::TidakDitemukan;
+    }
+    int64_t waktu = LayananWaktu::sekarang();
+    if (!terapkanKembali(mhs, slot, waktu, pinjaman, penerima)) {
+        return HasilKembali::TidakDipinjam;
+    }
+
+    PenulisBiner event;
+    event.str(mhs.nim);
+    event.str(bookId);
+    event.u64(static_cast<uint64_t>(waktu));
+    catatWal(TipeWal::Kembali, event);
+    return HasilKembali::Berhasil;
+}
+
+// The student's outstanding loans in borrow order (catalog slot, loan). Walks the student's own
+// loan history, so the cost does not depend on how many loans other students have.
+vector<pair<size_t, RegistriPinjaman::Pinjaman>> pinjamanBerjalan(Mahasiswa& mhs) {
+    vector<pair<size_t, RegistriPinjaman::Pinjaman>> hasil;
+    RegistriPinjaman::Pinjaman pinjaman;
+    lock_guard<mutex> lock(mhs.kunci.m);
+    for (Node<Aktivitas>* current = mhs.riwayat_peminjaman.getHead(); current != nullptr; current = current->next) {
+        const Aktivitas& a = current->data;
+        // Still outstanding if the slot's current loan is this very one
+        if (pinjamanAktif.cari(a.ref, pinjaman) && pinjaman.nim == mhs.nim && pinjaman.waktuPinjam == a.waktu &&
+            none_of(hasil.begin(), hasil.end(), [&a](const pair<size_t, RegistriPinjaman::Pinjaman>& p) { return p.first == a.ref; })) {
+            hasil.emplace_back(a.ref, pinjaman);
+        }
+    }
+    return hasil;
+}
+
+// Puts the student in line for a book and records the hold in their activity history, unless the
+// book is on the shelf or they are already in line (live holds and WAL replay)
+AntreanPesanan::Hasil terapkanPesan(Mahasiswa& mhs, size_t slot, int64_t waktu, size_t& posisi) {
+    AntreanPesanan::Hasil hasil = antreanPesanan.tambah(static_cast<uint32_t>(slot), mhs.nim, waktu, daftarBuku, posisi);
+    if (hasil == AntreanPesanan::Hasil::Ditambahkan) {
+        lock_guard<mutex> lock(mhs.kunci.m);
+        mhs.riwayat_aktivitas.add({waktu, static_cast<uint32_t>(slot), JenisAktivitas::PesanBuku});
+        mhs.pesanan_aktif.push_back(static_cast<uint32_t>(slot));
+    }
+    return hasil;
+}
+
+// Puts the student in line for a book that is out on loan and logs it (no console output).
+// `slot` receives the book's catalog slot when the ID is found, `posisi` the student's 1-based
+// position when they are (or already were) in line.
+HasilPesan pesanBuku(Mahasiswa& mhs, const string& bookId, const string& dosenRujukan, size_t& slot, size_t& posisi) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Pesan);
+    posisi = 0;
+    slot = daftarBuku.findSlotById(bookId);
+    if (slot == KatalogBuku::NOT_FOUND || daftarBuku.at(slot).dosen_referensi != dosenRujukan) {
+        return HasilPesan::TidakDitemukan;
+    }
+    RegistriPinjaman::Pinjaman pinjaman;
+    if (pinjamanAktif.cari(static_cast<uint32_t>(slot), pinjaman) && pinjaman.nim == mhs.nim) {
+        return HasilPesan::SedangDipinjam;
+    }
+    int64_t waktu = LayananWaktu::sekarang();
+    switch (terapkanPesan(mhs, slot, waktu, posisi)) {
+        case AntreanPesanan::Hasil::Tersedia:
+            return HasilPesan::Tersedia;
+        case AntreanPesanan::Hasil::SudahMengantre:
+            return HasilPesan::SudahMengantre;
+        case AntreanPesanan::Hasil::Ditambahkan:
+            break;
+    }
+
+    PenulisBiner event;
+    event.str(mhs.nim);
+    event.str(bookId);
+    event.u64(static_cast<uint64_t>(waktu));
+    catatWal(TipeWal::Pesan, event);
+    return HasilPesan::Berhasil;
+}
+
+// The books the student is waiting for (catalog slot, 1-based position), in the order the holds
+// were placed. Reads the student's own held slots, one shard lock per hold actually waiting.
+vector<pair<size_t, size_t>> pesananBerjalan(Mahasiswa& mhs) {
+    vector<pair<size_t, size_t>> hasil;
+    lock_guard<mutex> lock(mhs.kunci.m);
+    for (uint32_t slot : mhs.pesanan_aktif) {
+        size_t posisi = antreanPesanan.posisi(slot, mhs.nim);
+        if (posisi > 0) hasil.emplace_back(slot, posisi); // 0 only while a hand-off is under way
+    }
+    return hasil;
+}
+
+// Records an overdue entry in the activity history of every student whose loan came due by
+// `waktu`, and retires consultation bookings on days that have ended. Those students keep their
+// registered mentor (and the library) and may book a new session. Runs at quiescent points: at
+// startup, after a batch command, a server loop round, a main menu. Retiring needs no log
+// record; it follows from the time alone.
+void periksaJatuhTempo(int64_t waktu) {
+    dataDosen.majukan(waktu);
+
+    vector<RegistriPinjaman::Jatuh> jatuh;
+    pinjamanAktif.periksa(waktu, jatuh);
+    for (const RegistriPinjaman::Jatuh& j : jatuh) {
+        Mahasiswa* mhs = cariMahasiswa(j.nim);
+        if (mhs == nullptr) continue;
+        Aktivitas terlambat{j.jatuhTempo, j.slot, JenisAktivitas::Terlambat};
+        {
+            lock_guard<mutex> lock(mhs->kunci.m);
+            mhs->riwayat_aktivitas.add(terlambat);
+        }
+
+        PenulisBiner event;
+        event.str(mhs->nim);
+        event.u8(static_cast<uint8_t>(terlambat.jenis));
+        event.u64(static_cast<uint64_t>(terlambat.waktu));
+        event.u32(terlambat.ref);
+        catatWal(TipeWal::Aktivitas, event);
+    }
+}
+
+// Tables of the current student's outstanding loans and holds; false if there are no loans
+bool displayPinjamanAktif() {
+    vector<pair<size_t, RegistriPinjaman::Pinjaman>> pinjaman = pinjamanBerjalan(*currentUser);
+    vector<pair<size_t, size_t>> pesanan = pesananBerjalan(*currentUser);
+    string out;
+    if (pinjaman.empty()) {
+        out += "   Tidak ada buku yang sedang dipinjam.\n\n";
+    } else {
+        TABEL_PINJAMAN_AKTIF.appendHeader(out);
+        int64_t sekarang = LayananWaktu::sekarang();
+        for (const pair<size_t, RegistriPinjaman::Pinjaman>& p : pinjaman) {
+            const Buku& buku = daftarBuku.at(p.first);
+            bool terlambat = p.second.terlambat() || sekarang > p.second.jatuhTempo;
+            TABEL_PINJAMAN_AKTIF.appendRow(out, {buku.id, buku.judul, LayananWaktu::tanggal(p.second.jatuhTempo), terlambat ? "Terlambat" : "Dipinjam"});
+        }
+        out += '\n';
+    }
+    if (!pesanan.empty()) {
+        out += "   Antrean buku Anda:\n";
+        TABEL_PESANAN.appendHeader(out);
+        for (const pair<size_t, size_t>& p : pesanan) {
+            const Buku& buku = daftarBuku.at(p.first);
+            TABEL_PESANAN.appendRow(out, {buku.id, buku.judul, to_string(p.second)});
+        }
+        out += '\n';
+    }
+    cout << out;
+    return !pinjaman.empty();
+}
+
+void returnBook(const string& bookId) {
+    size_t slot = KatalogBuku::NOT_FOUND;
+    RegistriPinjaman::Pinjaman pinjaman;
+    string penerima;
+    switch (kembalikanBuku(*currentUser, bookId, slot, pinjaman, penerima)) {
+        case HasilKembali::Berhasil:
+            sinkronkanWal(); // Confirm only once the return is durable
+            cout << "\n   Buku \"" << daftarBuku.at(slot).judul << "\" telah berhasil dikembalikan.\n";
+            if (pinjaman.terlambat() || LayananWaktu::sekarang() > pinjaman.jatuhTempo) {
+                cout << "   Pengembalian terlambat (jatuh tempo " << LayananWaktu::tanggal(pinjaman.jatuhTempo) << ").\n";
+            }
+            if (!penerima.empty()) {
+                cout << "   Buku langsung diteruskan ke mahasiswa berikutnya dalam antrean.\n";
+            }
+            break;
+        case HasilKembali::TidakDipinjam:
+            cout << "\n   Buku \"" << daftarBuku.at(slot).judul << "\" tidak sedang Anda pinjam.\n";
+            break;
+        case HasilKembali::TidakDitemukan:
+            cout << "\nID Buku tidak ditemukan.\n";
+            break;
+    }
+    pressEnterToContinue();
+}
+
+void displayRekomendasi(const string& bookId) {
+    clearScreen();
+    displayHeader();
+    size_t slot = daftarBuku.findSlotById(bookId);
+    if (slot == KatalogBuku::NOT_FOUND) {
+        cout << "\nID Buku tidak ditemukan.\n";
+        pressEnterToContinue();
+        return;
+    }
+    cout << "   Mahasiswa yang meminjam \"" << daftarBuku.at(slot).judul << "\" juga meminjam:\n\n";
+    string out;
+    TABEL_REKOMENDASI.appendHeader(out);
+    vector<RekomendasiBuku::Skor> saran = cariRekomendasi(bookId, RekomendasiBuku::TOP_K);
+    if (saran.empty()) {
+        out += "Belum ada data peminjaman bersama untuk buku ini.\n";
+    }
+    for (const RekomendasiBuku::Skor& skor : saran) {
+        const Buku& buku = daftarBuku.at(skor.slot);
+        TABEL_REKOMENDASI.appendRow(out, {buku.id, buku.judul, to_string(skor.jumlah) + " mahasiswa"});
+    }
+    out += '\n';
+    cout << out;
+    pressEnterToContinue();
+}
+
+BukuView searchBooks(const string& keyword, const string& dosenRujukan) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::CariBuku);
+    BukuView searchResults = {daftarBuku.cariJudul(keyword, dosenRujukan)};
+    daftarBuku.sortByJudul(searchResults.slots);
+    return searchResults;
+}
+
+BukuView filterAvailableBooks(const string& dosenRujukan) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::FilterBuku);
+    BukuView filteredResults;
+    for (size_t slot : daftarBuku.slotsByDosen(dosenRujukan)) { // Posting list is already in title order
+        if (daftarBuku.isTersedia(slot)) {
+            filteredResults.slots.push_back(slot);
+        }
+    }
+    return filteredResults;
+}
+
+// ===============================================
+//           CAMPUS NAVIGATION SERVICE FUNCTIONS
+// ===============================================
+
+// Shortest route from a station or street to the nearest campus building. False if the place is
+// unknown or no campus building can be reached from it.
+bool cariRuteKampus(const string& asal, RuteJalan& rute) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Rute);
+    rute.titik.clear();
+    rute.meter = GrafJalan::TAK_HINGGA;
+    uint32_t awal = petaKampus.cariTitik(asal);
+    if (awal == GrafJalan::TIDAK_ADA) return false;
+    rute.meter = petaKampus.cariJalurKampus(awal, &rute.titik);
+    return rute.meter != GrafJalan::TAK_HINGGA;
+}
+
+// Shortest route between two named places, served from the route cache when the pair was asked
+// before. False if either place is unknown or the destination cannot be reached.
+bool cariRute(const string& asal, const string& tujuan, RuteJalan& rute) {
+    PengukurOperasi ukur(metrikOperasi, Operasi::Rute);
+    rute.titik.clear();
+    rute.meter = GrafJalan::TAK_HINGGA;
+    uint32_t awal = petaKampus.cariTitik(asal);
+    uint32_t akhir = petaKampus.cariTitik(tujuan);
+    if (awal == GrafJalan::TIDAK_ADA || akhir == GrafJalan::TIDAK_ADA) return false;
+    if (!cacheRute.ambil(awal, akhir, rute)) {
+        rute.meter = petaKampus.cariJalur(awal, akhir, &rute.titik);
+        cacheRute.simpan(awal, akhir, rute); // Unreachable pairs are cached too
+    }
+    return rute.meter != GrafJalan::TAK_HINGGA;
+}
+
+// "1.5 km" / "800 m"
+string formatJarak(uint32_t meter) {
+    if (meter < 1000) return to_string(meter) + " m";
+    char teks[32];
+    snprintf(teks, sizeof(teks), "%.1f km", meter / 1000.0);
+    return teks;
+}
+
+void displayRoute(const string& stationName) {
+    RuteJalan rute;
+    if (cariRuteKampus(stationName, rute)) {
+        clearScreen();
+        displayHeader();
+        cout << "   " << stationName << " ke " << KAMPUS_CAKRAWALA << "\n\n";
+
+        int step = 1;
+        for (uint32_t titik : rute.titik) {
+            cout << "   " << step++ << ". " << petaKampus.namaTitik(titik) << '\n';
+        }
+        cout << "\n   Jarak tempuh: " << formatJarak(rute.meter) << '\n';
+        cout << '\n';
+    } else {
+        cout << "\n   Rute dari titik tersebut belum tersedia.\n";
+    }
+    pressEnterToContinue();
+}
+
+// ===============================================
+//           PERSISTENCE (SNAPSHOT + WRITE-AHEAD LOG)
+// ===============================================
+
+// Run with: ./smartstudent --data <dir> [--batch ...|--server ...]
+//   <dir>/snapshot.bin  compact binary image of all state, memory-mapped at startup
+//   <dir>/wal.log       borrow, return, register and activity events since that snapshot
+// Startup maps the snapshot, loads the small catalog (mentors, queues, books) and replays the
+// log tail. Students stay encoded in the mapping until their first lookup, so startup time does
+// not grow with the number of students or history entries. Once the log passes
+// SNAPSHOT_SETIAP_REKAMAN records a new snapshot is written at the next quiescent point (after a
+// batch command, a server loop round or a logout) and the log is emptied.
+// Interactive confirmations wait for the group commit; batch and server replies do not, and the
+// log is flushed on exit. Without --data nothing is read or written.
+
+const size_t SNAPSHOT_SETIAP_REKAMAN = 50000;
+
+// History: u32 count, then 13 bytes per entry (u8 kind, u64 time, u32 ref)
+const size_t UKURAN_AKTIVITAS = 13;
+
+void encodeRiwayat(PenulisBiner& out, const LinkedList<Aktivitas>& riwayat) {
+    out.u32(static_cast<uint32_t>(riwayat.size()));
+    for (Node<Aktivitas>* current = riwayat.getHead(); current != nullptr; current = current->next) {
+        out.u8(static_cast<uint8_t>(current->data.jenis));
+        out.u64(static_cast<uint64_t>(current->data.waktu));
+        out.u32(current->data.ref);
+    }
+}
+
+// Reads one entry; an unknown kind marks the input corrupt
+Aktivitas decodeAktivitas(PembacaBiner& in) {
+    Aktivitas a;
+    uint8_t jenis = in.u8();
+    a.jenis = static_cast<JenisAktivitas>(jenis);
+    a.waktu = static_cast<int64_t>(in.u64());
+    a.ref = in.u32();
+    if (jenis < static_cast<uint8_t>(JenisAktivitas::PinjamBuku) || jenis > static_cast<uint8_t>(JenisAktivitas::PindahKonsultasi)) {
+        in.ok = false;
+    }
+    return a;
+}
+
+bool decodeRiwayat(PembacaBiner& in, LinkedList<Aktivitas>& riwayat) {
+    uint32_t n = in.u32();
+    for (uint32_t i = 0; i < n && in.ok; i++) {
+        Aktivitas a = decodeAktivitas(in);
+        if (in.ok) riwayat.add(a);
+    }
+    return in.ok;
+}
+
+void lewatiRiwayat(PembacaBiner& in) {
+    in.lewati(size_t(in.u32()) * UKURAN_AKTIVITAS);
+}
+
+// Student record: nim, password, nama, u8 registered, mentor name, loans, activities
+void encodeMahasiswa(PenulisBiner& out, const Mahasiswa& mhs) {
+    lock_guard<mutex> lock(mhs.kunci.m);
+    out.str(mhs.nim);
+    out.str(mhs.password);
+    out.str(mhs.nama);
+    out.u8(mhs.sudah_daftar_konsultasi ? 1 : 0);
+    out.str(mhs.dosen_konsultasi_terdaftar);
+    encodeRiwayat(out, mhs.riwayat_peminjaman);
+    encodeRiwayat(out, mhs.riwayat_aktivitas);
+}
+
+bool decodeMahasiswa(PembacaBiner& in, Mahasiswa& mhs) {
+    mhs.nim = in.str();
+    mhs.password = in.str();
+    mhs.nama = in.str();
+    mhs.sudah_daftar_konsultasi = in.u8() != 0;
+    mhs.dosen_konsultasi_terdaftar = in.str();
+    if (!decodeRiwayat(in, mhs.riwayat_peminjaman) || !decodeRiwayat(in, mhs.riwayat_aktivitas)) return false;
+    for (Node<Aktivitas>* current = mhs.riwayat_peminjaman.getHead(); current != nullptr; current = current->next) {
+        RekomendasiBuku::geserJendela(mhs.pinjaman_terakhir, current->data.ref);
+    }
+    // Holds are restored with the catalog, before any student is decoded
+    for (Node<Aktivitas>* current = mhs.riwayat_aktivitas.getHead(); current != nullptr; current = current->next) {
+        const Aktivitas& a = current->data;
+        if (a.jenis == JenisAktivitas::PesanBuku && antreanPesanan.posisi(a.ref, mhs.nim) > 0 &&
+            find(mhs.pesanan_aktif.begin(), mhs.pesanan_aktif.end(), a.ref) == mhs.pesanan_aktif.end()) {
+            mhs.pesanan_aktif.push_back(a.ref);
+        }
+    }
+    return true;
+}
+
+// Skips the rest of a student record after its NIM
+void lewatiMahasiswa(PembacaBiner& in) {
+    in.lewatiStr();
+    in.lewatiStr();
+    in.u8();
+    in.lewatiStr();
+    lewatiRiwayat(in);
+    lewatiRiwayat(in);
+}
+
+#ifdef _WIN32
+
+Mahasiswa* cariMahasiswa(const string& nim) {
+    lock_guard<mutex> lock(kunciDataMahasiswa);
+    auto it = dataMahasiswa.find(nim);
+    return it == dataMahasiswa.end() ? nullptr : &it->second;
+}
+
+uint64_t catatWal(TipeWal, const PenulisBiner&) { return 0; }
+void sinkronkanWal() {}
+void snapshotBilaPerlu() {}
+
+#else
+
+// Finds a student by NIM. Students not looked up yet are decoded from the mapped snapshot on
+// first use and stay in dataMahasiswa from then on.
+Mahasiswa* cariMahasiswa(const string& nim) {
+    lock_guard<mutex> lock(kunciDataMahasiswa);
+    auto it = dataMahasiswa.find(nim);
+    if (it != dataMahasiswa.end()) {
+        return &it->second;
+    }
+    if (snapshotAktif.terbuka()) {
+        PembacaBiner in = snapshotAktif.cariRekaman(nim);
+        Mahasiswa mhs;
+        if (in.ok && decodeMahasiswa(in, mhs)) {
+            return &dataMahasiswa.emplace(nim, std::move(mhs)).first->second;
+        }
+    }
+    return nullptr;
+}
+
+// Queues an event for the log (returns its LSN, or 0 without --data)
+uint64_t catatWal(TipeWal tipe, const PenulisBiner& isi) {
+    return walAktif == nullptr ? 0 : walAktif->append(tipe, isi);
+}
+
+// Waits until every logged event is durable
+void sinkronkanWal() {
+    if (walAktif != nullptr) walAktif->flush();
+}
+
+// Catalog section: mentors with their week (u8 weekdays, u32 n, n x (u32 minute, u32 seats)) and
+// bookings in session order (nim, name, registration date, u64 session start), books with their
+// availability, the co-borrow rows (u32 book slot, u32 n, n x (u32 other slot, u32 count)), the
+// outstanding loans (u32 book slot, nim, u64 borrow time, u64 due time, u8 overdue already
+// reported), then the holds in line order (u32 book slot, nim, u64 time)
+void encodeKatalog(PenulisBiner& out) {
+    out.u32(static_cast<uint32_t>(dataDosen.size()));
+    for (uint32_t id = 0; id < dataDosen.size(); id++) {
+        const Dosen& d = dataDosen.at(id);
+        out.str(d.id);
+        out.str(d.nama);
+        out.str(d.mata_kuliah);
+        const PolaJadwal& pola = dataDosen.polaJadwal(id);
+        out.u8(pola.hari);
+        out.u32(static_cast<uint32_t>(pola.sesi.size()));
+        for (const PolaJadwal::Sesi& sesi : pola.sesi) {
+            out.u32(sesi.menit);
+            out.u32(sesi.kapasitas);
+        }
+        dataDosen.bacaAntrean(id, [&out](const JadwalKonsultasi& antrean) {
+            out.u32(static_cast<uint32_t>(antrean.size()));
+            antrean.untukSetiap([&out](const Konsultasi& k) {
+                out.str(k.nim_mahasiswa);
+                out.str(k.nama_mahasiswa);
+                out.str(k.tanggal_daftar);
+                out.u64(static_cast<uint64_t>(k.jadwal));
+            });
+        });
+    }
+    out.u64(daftarBuku.size());
+    for (size_t slot = 0; slot < daftarBuku.size(); slot++) {
+        const Buku& b = daftarBuku.at(slot);
+        out.str(b.id);
+        out.str(b.judul);
+        out.str(b.dosen_referensi);
+        out.u8(daftarBuku.isTersedia(slot) ? 1 : 0);
+    }
+    out.u64(rekomendasiBuku.jumlahBaris());
+    rekomendasiBuku.untukSetiapBaris([&out](uint32_t slot, const vector<RekomendasiBuku::Skor>& isiBaris) {
+        out.u32(slot);
+        out.u32(static_cast<uint32_t>(isiBaris.size()));
+        for (const RekomendasiBuku::Skor& sel : isiBaris) {
+            out.u32(sel.slot);
+            out.u32(sel.jumlah);
+        }
+    });
+    out.u64(pinjamanAktif.size());
+    pinjamanAktif.untukSetiap([&out](uint32_t slot, const RegistriPinjaman::Pinjaman& p) {
+        out.u32(slot);
+        out.str(p.nim);
+        out.u64(static_cast<uint64_t>(p.waktuPinjam));
+        out.u64(static_cast<uint64_t>(p.jatuhTempo));
+        out.u8(p.terlambat() ? 1 : 0);
+    });
+    out.u64(antreanPesanan.size());
+    antreanPesanan.untukSetiap([&out](const AntreanPesanan::Pesanan& p) {
+        out.u32(p.slot);
+        out.str(p.nim);
+        out.u64(static_cast<uint64_t>(p.waktu));
+    });
+}
+
+bool muatKatalog(PembacaBiner in) {
+    uint32_t jumlahDosen = in.u32();
+    for (uint32_t i = 0; i < jumlahDosen && in.ok; i++) {
+        Dosen d;
+        d.id = in.str();
+        d.nama = in.str();
+        d.mata_kuliah = in.str();
+        PolaJadwal pola;
+        pola.hari = in.u8();
+        uint32_t jumlahSesi = in.u32();
+        if (!in.cukup(size_t(jumlahSesi) * 8)) break;
+        pola.sesi.resize(jumlahSesi);
+        for (PolaJadwal::Sesi& sesi : pola.sesi) {
+            sesi.menit = static_cast<uint16_t>(in.u32());
+            sesi.kapasitas = static_cast<uint16_t>(in.u32());
+        }
+        uint32_t id = dataDosen.add(d, pola);
+        uint32_t jumlahAntrean = in.u32();
+        for (uint32_t j = 0; j < jumlahAntrean && in.ok; j++) {
+            Konsultasi k;
+            k.nim_mahasiswa = in.str();
+            k.nama_mahasiswa = in.str();
+            k.tanggal_daftar = in.str();
+            k.nama_dosen = d.nama;
+            int64_t jadwal = static_cast<int64_t>(in.u64());
+            if (in.ok) dataDosen.daftar(id, k, jadwal, true); // Saved in session order
+        }
+    }
+    uint64_t jumlahBuku = in.u64();
+    vector<Buku> buku;
+    vector<bool> tersedia;
+    for (uint64_t i = 0; i < jumlahBuku && in.ok; i++) {
+        Buku b;
+        b.id = in.str();
+        b.judul = in.str();
+        b.dosen_referensi = in.str();
+        buku.push_back(std::move(b));
+        tersedia.push_back(in.u8() != 0);
+    }
+    daftarBuku.muatMassal(std::move(buku), tersedia);
+    uint64_t jumlahBaris = in.u64();
+    vector<RekomendasiBuku::Skor> isiBaris;
+    for (uint64_t i = 0; i < jumlahBaris && in.ok; i++) {
+        uint32_t slot = in.u32();
+        uint32_t n = in.u32();
+        if (!in.cukup(size_t(n) * 8)) break;
+        isiBaris.resize(n);
+        for (RekomendasiBuku::Skor& sel : isiBaris) {
+            sel.slot = in.u32();
+            sel.jumlah = in.u32();
+        }
+        rekomendasiBuku.muatBaris(slot, isiBaris);
+    }
+    uint64_t jumlahPinjaman = in.u64();
+    for (uint64_t i = 0; i < jumlahPinjaman && in.ok; i++) {
+        uint32_t slot = in.u32();
+        string nim = in.str();
+        int64_t waktuPinjam = static_cast<int64_t>(in.u64());
+        int64_t jatuhTempo = static_cast<int64_t>(in.u64());
+        bool terlambat = in.u8() != 0;
+        if (in.ok) pinjamanAktif.catat(slot, nim, waktuPinjam, jatuhTempo, terlambat);
+    }
+    uint64_t jumlahPesanan = in.u64();
+    for (uint64_t i = 0; i < jumlahPesanan && in.ok; i++) {
+        uint32_t slot = in.u32();
+        string nim = in.str();
+        int64_t waktu = static_cast<int64_t>(in.u64());
+        size_t posisi = 0;
+        if (in.ok && slot < daftarBuku.size()) antreanPesanan.tambah(slot, nim, waktu, daftarBuku, posisi); // Saved front to back
+    }
+    return in.ok;
+}
+
+// Applies one logged event to the in-memory state (same code path as the live request)
+void terapkanEvent(TipeWal tipe, PembacaBiner& in) {
+    Mahasiswa* mhs = cariMahasiswa(in.str());
+    if (mhs == nullptr) return;
+    switch (tipe) {
+        case TipeWal::Pinjam: {
+            string bookId = in.str();
+            int64_t waktu = static_cast<int64_t>(in.u64());
+            size_t slot = daftarBuku.findSlotById(bookId);
+            if (in.ok && slot != KatalogBuku::NOT_FOUND) {
+                daftarBuku.setTersedia(slot, false);
+                terapkanPinjam(*mhs, slot, waktu);
+            }
+            break;
+        }
+        case TipeWal::Daftar: {
+            uint32_t dosenId = dataDosen.findByKode(in.str());
+            int64_t waktu = static_cast<int64_t>(in.u64());
+            if (in.ok && dosenId != RegistriDosen::NOT_FOUND) {
+                terapkanDaftar(*mhs, dosenId, waktu);
+            }
+            break;
+        }
+        case TipeWal::Aktivitas: {
+            Aktivitas a = decodeAktivitas(in);
+            if (in.ok) {
+                if (a.jenis == JenisAktivitas::Terlambat) pinjamanAktif.tandaiTerlambat(a.ref); // Already reported
+                lock_guard<mutex> lock(mhs->kunci.m);
+                mhs->riwayat_aktivitas.add(a);
+            }
+            break;
+        }
+        case TipeWal::Kembali: {
+            string bookId = in.str();
+            int64_t waktu = static_cast<int64_t>(in.u64());
+            size_t slot = daftarBuku.findSlotById(bookId);
+            RegistriPinjaman::Pinjaman pinjaman;
+            string penerima;
+            if (in.ok && slot != KatalogBuku::NOT_FOUND) {
+                terapkanKembali(*mhs, slot, waktu, pinjaman, penerima);
+            }
+            break;
+        }
+        case TipeWal::Pesan: {
+            string bookId = in.str();
+            int64_t waktu = static_cast<int64_t>(in.u64());
+            size_t slot = daftarBuku.findSlotById(bookId);
+            size_t posisi = 0;
+            if (in.ok && slot != KatalogBuku::NOT_FOUND) {
+                terapkanPesan(*mhs, slot, waktu, posisi);
+            }
+            break;
+        }
+        case TipeWal::Batal: {
+            int64_t waktu = static_cast<int64_t>(in.u64());
+            if (in.ok) terapkanBatal(*mhs, waktu);
+            break;
+        }
+        case TipeWal::Pindah: {
+            int64_t dari = static_cast<int64_t>(in.u64());
+            int64_t waktu = static_cast<int64_t>(in.u64());
+            int64_t jadwal = 0;
+            if (in.ok) terapkanPindah(*mhs, dari, waktu, jadwal);
+            break;
+        }
+    }
+}
+
+// Replays every record newer than `lsn` and advances `lsn` to the last one. Stops at the first
+// short or corrupt record (a write torn by a crash) and cuts the file there. Returns the number
+// of intact records in the file.
+size_t replayWal(int fd, uint64_t& lsn) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) return 0;
+    string isi(static_cast<size_t>(st.st_size), '\0');
+    size_t dibaca = 0;
+    while (dibaca < isi.size()) {
+        ssize_t n = pread(fd, &isi[dibaca], isi.size() - dibaca, static_cast<off_t>(dibaca));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        dibaca += static_cast<size_t>(n);
+    }
+    isi.resize(dibaca);
+
+    size_t pos = 0, jumlah = 0;
+    while (isi.size() - pos >= 8) {
+        uint32_t panjang, checksum;
+        memcpy(&panjang, isi.data() + pos, 4);
+        memcpy(&checksum, isi.data() + pos + 4, 4);
+        const char* payload = isi.data() + pos + 8;
+        if (panjang < 9 || isi.size() - pos - 8 < panjang || checksumFnv1a(payload, panjang) != checksum) {
+            break;
+        }
+        PembacaBiner in(payload, payload + panjang);
+        uint64_t lsnRekaman = in.u64();
+        TipeWal tipe = static_cast<TipeWal>(in.u8());
+        if (lsnRekaman > lsn) { // Older records are already in the snapshot
+            terapkanEvent(tipe, in);
+            lsn = lsnRekaman;
+        }
+        pos += 8 + panjang;
+        jumlah++;
+    }
+    if (pos < isi.size()) {
+        cerr << "WAL: " << (isi.size() - pos) << " byte tidak utuh di akhir log dibuang.\n";
+        if (ftruncate(fd, static_cast<off_t>(pos)) != 0) {
+            cerr << "WAL tidak dapat dipotong: " << strerror(errno) << "\n";
+        }
+    }
+    return jumlah;
+}
+
+// Writes a new snapshot next to the old one and swaps it in with rename(), then empties the log.
+// Must run at a quiescent point: no request may be changing state while it runs.
+bool tulisSnapshot() {
+    uint64_t lsn = walAktif->flush();
+    string path = direktoriData + "/snapshot.bin";
+    string tmp = path + ".tmp";
+
+    lock_guard<mutex> lock(kunciDataMahasiswa); // Also keeps lookups off the mapping while it is replaced
+    PenulisSnapshot out;
+    if (!out.buka(tmp)) {
+        cerr << "Snapshot tidak dapat ditulis: " << strerror(errno) << "\n";
+        return false;
+    }
+    PenulisBiner rekaman;
+    for (const auto& entry : dataMahasiswa) {
+        rekaman.data.clear();
+        encodeMahasiswa(rekaman, entry.second);
+        out.tambahMahasiswa(entry.first, rekaman.data.data(), rekaman.data.size());
+    }
+    // Students never looked up since the last snapshot are copied byte for byte
+    if (snapshotAktif.terbuka()) {
+        PembacaBiner in = snapshotAktif.rekaman();
+        while (in.ok && in.p < in.akhir) {
+            const char* awal = in.p;
+            string nim = in.str();
+            lewatiMahasiswa(in);
+            if (in.ok && dataMahasiswa.find(nim) == dataMahasiswa.end()) {
+                out.tambahMahasiswa(nim, awal, static_cast<size_t>(in.p - awal));
+            }
+        }
+    }
+    out.mulaiKatalog();
+    rekaman.data.clear();
+    encodeKatalog(rekaman);
+    out.tulis(rekaman.data.data(), rekaman.data.size());
+
+    if (!out.selesai(lsn) || rename(tmp.c_str(), path.c_str()) != 0) {
+        cerr << "Snapshot tidak dapat ditulis: " << strerror(errno) << "\n";
+        unlink(tmp.c_str());
+        return false;
+    }
+    int dirFd = open(direktoriData.c_str(), O_RDONLY | O_CLOEXEC);
+    if (dirFd >= 0) { // Make the rename itself durable
+        fsync(dirFd);
+        close(dirFd);
+    }
+    if (snapshotAktif.buka(path) != 1) {
+        cerr << "Snapshot baru tidak dapat dibuka.\n";
+        return false;
+    }
+    walAktif->kosongkan(lsn);
+    return true;
+}
+
+// Compacts the log into a new snapshot once it has grown past the threshold
+void snapshotBilaPerlu() {
+    if (walAktif != nullptr && walAktif->rekaman() >= SNAPSHOT_SETIAP_REKAMAN) {
+        tulisSnapshot();
+    }
+}
+
+// Opens (or creates) the data directory: maps the snapshot, replays the log and starts the
+// group-commit writer. A missing snapshot means a first run: the CSV import (or the demo data)
+// is loaded and saved.
+bool mulaiPersistensi(const string& dir, const string& direktoriImpor) {
+    direktoriData = dir;
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        cerr << "Direktori data tidak dapat dibuat: " << dir << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    int status = snapshotAktif.buka(dir + "/snapshot.bin");
+    if (status < 0 || (status > 0 && !muatKatalog(snapshotAktif.katalog()))) {
+        cerr << "Snapshot rusak: " << dir << "/snapshot.bin\n";
+        return false;
+    }
+    if (status == 0) {
+        if (!muatDataAwal(direktoriImpor)) return false;
+    } else {
+        if (!direktoriImpor.empty()) {
+            cerr << "Snapshot sudah ada di " << dir << "; --import " << direktoriImpor << " diabaikan.\n";
+        }
+        initializeRoutes();
+    }
+
+    int fd = open((dir + "/wal.log").c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        cerr << "WAL tidak dapat dibuka: " << strerror(errno) << "\n";
+        return false;
+    }
+    uint64_t lsn = snapshotAktif.lsn();
+    size_t rekaman = replayWal(fd, lsn);
+    walAktif = new WriteAheadLog(fd, lsn, rekaman);
+    if (status == 0) {
+        return tulisSnapshot();
+    }
+    return true;
+}
+
+// Flushes the log and stops its writer (registered with atexit)
+void tutupPersistensi() {
+    delete walAktif;
+    walAktif = nullptr;
+}
+
+#endif
+
+// ===============================================
+//           METRICS (LATENCY HISTOGRAMS)
+// ===============================================
+
+// "850 ns" / "12.3 us" / "4.1 ms"
+string formatDurasi(uint64_t ns) {
+    if (ns < 1000) return to_string(ns) + " ns";
+    char teks[32];
+    snprintf(teks, sizeof(teks), ns < 1000000 ? "%.1f us" : "%.1f ms", ns < 1000000 ? ns / 1e3 : ns / 1e6);
+    return teks;
+}
+
+// Count, mean and percentiles of every operation with at least one recording (indexed by Operasi)
+string tabelMetrikTeks(const vector<MetrikOperasi::Ringkasan>& ringkasan) {
+    string out;
+    TABEL_METRIK.appendHeader(out);
+    bool ada = false;
+    for (size_t i = 0; i < ringkasan.size(); i++) {
+        Operasi op = static_cast<Operasi>(i);
+        const MetrikOperasi::Ringkasan& r = ringkasan[i];
+        if (r.jumlah == 0) continue;
+        TABEL_METRIK.appendRow(out, {MetrikOperasi::nama(op), to_string(r.jumlah), formatDurasi(r.totalNs / r.jumlah),
+                                     formatDurasi(r.persentil(50)), formatDurasi(r.persentil(90)), formatDurasi(r.persentil(99)),
+                                     formatDurasi(r.persentil(99.9)), formatDurasi(r.maksNs)});
+        ada = true;
+    }
+    if (!ada) out += "Belum ada operasi yang tercatat.\n";
+    return out;
+}
+
+// Every operation recorded so far
+string laporanMetrikTeks() {
+    vector<MetrikOperasi::Ringkasan> ringkasan;
+    for (size_t i = 0; i < MetrikOperasi::JUMLAH_OPERASI; i++) ringkasan.push_back(metrikOperasi.baca(static_cast<Operasi>(i)));
+    return tabelMetrikTeks(ringkasan);
+}
+
+// "operations":[{"op":"login","count":3,"mean_ns":..,"p50_ns":..,...}] (every operation, recorded or not)
+string jsonMetrik() {
+    string out = "\"operations\":[";
+    for (size_t i = 0; i < MetrikOperasi::JUMLAH_OPERASI; i++) {
+        Operasi op = static_cast<Operasi>(i);
+        MetrikOperasi::Ringkasan r = metrikOperasi.baca(op);
+        out += i ? ",{" : "{";
+        out += "\"op\":" + jsonEscape(MetrikOperasi::nama(op)) + ",\"count\":" + to_string(r.jumlah) +
+               ",\"mean_ns\":" + to_string(r.jumlah ? r.totalNs / r.jumlah : 0) +
+               ",\"p50_ns\":" + to_string(r.persentil(50)) + ",\"p90_ns\":" + to_string(r.persentil(90)) +
+               ",\"p99_ns\":" + to_string(r.persentil(99)) + ",\"p999_ns\":" + to_string(r.persentil(99.9)) +
+               ",\"max_ns\":" + to_string(r.maksNs) + "}";
+    }
+    return out + "]";
+}
+
+// Writes the metrics as JSON to the --metrics file, or as a table to stderr without one
+void tulisDumpMetrik() {
+    if (berkasMetrik.empty()) {
+        cerr << laporanMetrikTeks();
+        return;
+    }
+    ofstream out(berkasMetrik, ios::trunc);
+    out << "{" << jsonMetrik() << "}\n";
+    if (!out) cerr << "Metrik tidak dapat ditulis ke " << berkasMetrik << "\n";
+}
+
+// Registered with atexit when --metrics is given
+void dumpMetrikSaatKeluar() {
+    tulisDumpMetrik();
+}
+
+#ifdef __linux__
+// Blocks SIGUSR1 here and in every thread started later, and dumps the metrics from a dedicated
+// thread each time it arrives (sigwait, so the dump is not limited to async-signal-safe calls).
+// Must run before any other thread is started.
+void mulaiPemantauMetrik() {
+    sigset_t sinyal;
+    sigemptyset(&sinyal);
+    sigaddset(&sinyal, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &sinyal, nullptr);
+    thread([sinyal]() {
+        int diterima;
+        while (sigwait(&sinyal, &diterima) == 0) tulisDumpMetrik();
+    }).detach();
+}
+#endif
+
+// ===============================================
+//           CONSOLE UI FUNCTIONS
+// ===============================================
+
+void displayLoginMenu() {
+    string nim, password;
+    bool loggedIn = false;
+    string errorMessage = "";
+
+    while (!loggedIn) {
+        clearScreen();
+        displayHeader();
+
+        if (!errorMessage.empty()) {
+            cout << "   !!!" << errorMessage << "\n\n";
+            errorMessage = "";
+        }
+        
+        cout << "   LOGIN\n\n";
+        cout << "   > Username (NIM) : ";
+        cin >> nim;
+        cout << "   > Password       : ";
+        cin >> password;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer
+        if (cin.fail()) return; // Input closed before a password was read
+
+        // Call login function
+        loginUser(nim, password);
+        bool loginSuccess = currentUser != nullptr;
+
+        if (loginSuccess) {
+            loggedIn = true;
+            cout << "\n   Login berhasil! Selamat datang, " << currentUser->nama << "!\n";
+            pressEnterToContinue();
+        } else {
+            errorMessage = "Username / Password yang anda masukkan salah."; // Set error message
+        }
+    }
+}
+
+void displayMainMenu() {
+    int choice;
+    do {
+        periksaJatuhTempo(LayananWaktu::sekarang());
+        size_t terlambat = 0;
+        for (const pair<size_t, RegistriPinjaman::Pinjaman>& p : pinjamanBerjalan(*currentUser)) {
+            terlambat += p.second.terlambat();
+        }
+
+        clearScreen();
+        displayHeader();
+        cout << "   Selamat datang di portal Smart.Student, " << currentUser->nama << "\n\n";
+        if (terlambat > 0) {
+            cout << "   !!! " << terlambat << " buku melewati jatuh tempo. Segera kembalikan melalui menu Perpustakaan.\n\n";
+        }
+        cout << "      1. > Konsultasi Akademik\n";
+        cout << "      2. > Perpustakaan\n";
+        cout << "      3. > Riwayat Peminjaman\n";
+        cout << "      4. > Riwayat Aktivitas\n";
+        cout << "      5. > Navigasi Kampus\n";
+        cout << "      6. > Metrik Operasi\n";
+        cout << "      7. > Logout\n";
+        cout << "\n   Pilih Menu (1 - 7) = ";
+        cin >> choice;
+        if (cin.fail() && cin.eof()) return; // Input closed
+        if (cin.fail()) { // Not a number: treat as an invalid choice
+            cin.clear();
+            choice = 0;
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        switch (choice) {
+            case 1: KonsultasiAkademikMenu(); break;
+            case 2: 
+                if (!currentUser->sudah_daftar_konsultasi) {
+                    clearScreen();
+                    displayHeader();
+                    cout << "   !!! Anda harus memilih dosen untuk konsultasi akademik terlebih dahulu.\n\n";
+                    pressEnterToContinue();
+                } else {
+                    PerpustakaanMenu(); 
+                }
+                break;
+            case 3: RiwayatPeminjamanMenu(); break;
+            case 4: RiwayatAktivitasMenu(); break;
+            case 5: NavigasiKampusMenu(); break;
+            case 6: MetrikOperasiMenu(); break;
+            case 7:
+                cout << "\n" << "   " << currentUser->nama << " berhasil logout.\n";
+                pressEnterToContinue();
+                currentUser = nullptr; // Reset current user
+                break;
+            default:
+                cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
+                pressEnterToContinue();
+                break;
+        }
+    } while (currentUser != nullptr);
+}
+
+void KonsultasiAkademikMenu() {
+    clearScreen();
+    displayHeader();
+    cout << "   Antrean Konsultasi Akademik\n\n";
+
+    // Check user's current consultation status and display detailed queue if applicable
+    // This call will set currentUser->sudah_daftar_konsultasi and dosen_konsultasi_terdaftar
+    bool punyaJadwal = displayDetailedConsultationQueue(currentUser->nim);
+
+    if (punyaJadwal) {
+        // Booked students can move or cancel their booking instead of registering again
+        int choice;
+        cout << "      1. > Pindah Jadwal\n";
+        cout << "      2. > Batalkan Konsultasi\n";
+        cout << "      3. > Kembali\n";
+        cout << "\n   Pilih Menu (1 - 3) = ";
+        cin >> choice;
+        if (cin.fail()) { // Not a number: treat as an invalid choice
+            cin.clear();
+            choice = 0;
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        if (choice == 1) { // Move Booking
+            string tanggalInput;
+            cout << "\n   Jadwal paling awal yang diinginkan (dd-mm-yyyy, kosongkan untuk sesi berikutnya): ";
+            getline(cin, tanggalInput);
+            moveConsultationLogic(tanggalInput);
+        } else if (choice == 2) { // Cancel Booking
+            if (batalKonsultasi(*currentUser)) {
+                sinkronkanWal(); // Confirm only once the cancellation is durable
+                cout << "\n   Konsultasi telah dibatalkan. Daftarkan konsultasi kembali untuk mengakses perpustakaan.\n";
+            } else {
+                cout << "\n   Anda belum terdaftar dalam antrean konsultasi.\n";
+            }
+            pressEnterToContinue();
+        } else if (choice != 3) {
+            cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
+            pressEnterToContinue();
+        }
+        return;
+    }
+
+    // Display available mentors table ONLY if student holds no booking (none yet, or their
+    // session has passed)
+    string out;
+    TABEL_DOSEN.appendHeader(out);
+    for (const Dosen& dosen : dataDosen) { // Iterate through the mentor registry
+        TABEL_DOSEN.appendRow(out, {dosen.id, dosen.nama, dosen.mata_kuliah});
+    }
+    out += '\n';
+    cout << out;
+
+    // Menu options for new registration
+    int choice;
+    cout << "      1. > Daftarkan Konsultasi\n";
+    cout << "      2. > Lihat Antrean\n"; // This option now just calls the display function again
+    cout << "      3. > Kembali\n";
+    cout << "\n   Pilih Menu (1 - 3) = ";
+    cin >> choice;
+    if (cin.fail()) { // Not a number: treat as an invalid choice
+        cin.clear();
+        choice = 0;
+    }
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    if (choice == 1) { // Register Consultation
+        string idDosenInput;
+        cout << "\n   Masukkan ID Dosen yang dipilih untuk konsultasi: ";
+        cin >> idDosenInput;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        registerConsultationLogic(idDosenInput); // Calls the service logic
+    } else if (choice == 2) { // View Queue
+        clearScreen();
+        displayHeader();
+        cout << "   Lihat Antrean Konsultasi Akademik\n\n";
+        displayDetailedConsultationQueue(currentUser->nim); // Re-use the existing logic to show user's queue
+        pressEnterToContinue(); // Press enter after viewing the queue
+    } else if (choice == 3) {
+        // Return to main menu
+    } else {
+        cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
+        pressEnterToContinue();
+    }
+}
+
+void PerpustakaanMenu() {
+    string dosenRujukan = currentUser->dosen_konsultasi_terdaftar;
+    BukuView currentDisplayBuku; // Slots into daftarBuku; no books are copied
+
+    // Initialize currentDisplayBuku with all books from the relevant mentor on entry
+    currentDisplayBuku = booksByDosen(dosenRujukan);
+    
+    do { 
+        clearScreen();
+        displayHeader();
+        cout << "   Daftar buku perpustakaan rujukan (" << dosenRujukan << ")\n\n";
+
+        displayBooksTable(currentDisplayBuku);
+
+        cout << "      1. > Pinjam Buku\n";
+        cout << "      2. > Cari Buku\n";
+        cout << "      3. > Filter Buku (Tersedia)\n";
+        cout << "      4. > Reset Filter\n"; 
+        cout << "      5. > Rekomendasi Buku\n";
+        cout << "      6. > Kembalikan Buku\n";
+        cout << "      7. > Kembali ke Menu Utama\n"; 
+        cout << "\n   Pilih Menu (1 - 7) = ";
+        int subChoice;
+        cin >> subChoice;
+        if (cin.fail() && cin.eof()) return; // Input closed
+        if (cin.fail()) { // Not a number: treat as an invalid choice
+            cin.clear();
+            subChoice = 0;
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        string inputId;
+        string keyword;
+
+        switch (subChoice) {
+            case 1: { // Pinjam Buku
+                cout << "   Masukkan ID Buku yang dipilih : ";
+                cin >> inputId;
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                borrowBook(inputId, dosenRujukan); 
+                
+                // Refresh display after action: reset currentDisplayBuku to all books for this mentor
+                currentDisplayBuku = booksByDosen(dosenRujukan);
+                break;
+            }
+            case 2: { // Cari Buku
+                cout << "   Masukkan keyword buku: ";
+                getline(cin, keyword);
+                currentDisplayBuku = searchBooks(keyword, dosenRujukan); 
+                break;
+            }
+            case 3: { // Filter Buku (Tersedia)
+                currentDisplayBuku = filterAvailableBooks(dosenRujukan); 
+                break;
+            }
+            case 4: { // Reset Filter
+                currentDisplayBuku = booksByDosen(dosenRujukan);
+                break;
+            }
+            case 5: { // Rekomendasi Buku
+                cout << "   Masukkan ID Buku: ";
+                cin >> inputId;
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                displayRekomendasi(inputId);
+                break;
+            }
+            case 6: { // Kembalikan Buku
+                cout << "\n";
+                if (!displayPinjamanAktif()) {
+                    pressEnterToContinue();
+                    break;
+                }
+                cout << "   Masukkan ID Buku yang dikembalikan : ";
+                cin >> inputId;
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                returnBook(inputId);
+                currentDisplayBuku = booksByDosen(dosenRujukan);
+                break;
+            }
+            case 7: // Kembali ke Menu Utama
+                return; 
+            default:
+                cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
+                pressEnterToContinue();
+                // On invalid input, reset display to all books for this mentor
+                currentDisplayBuku = booksByDosen(dosenRujukan);
+                break;
+        }
+    } while (true);
+}
+
+void RiwayatPeminjamanMenu() {
+    clearScreen();
+    displayHeader();
+    cout << "   Riwayat peminjaman buku " << currentUser->nama << "\n\n";
+
+    {
+        PengukurOperasi ukur(metrikOperasi, Operasi::Riwayat);
+        lock_guard<mutex> lock(currentUser->kunci.m); // Released before waiting for Enter
+        if (currentUser->riwayat_peminjaman.isEmpty()) {
+            cout << "   !!! Belum meminjam buku apapun.\n";
+        } else {
+            string out;
+            TABEL_PEMINJAMAN.appendHeader(out);
+
+            Node<Aktivitas>* current = currentUser->riwayat_peminjaman.getHead();
+            while (current != nullptr) {
+                TABEL_PEMINJAMAN.appendRow(out, {LayananWaktu::tanggal(current->data.waktu), judulAktivitas(current->data)});
+                current = current->next;
+            }
+            cout << out;
+        }
+    }
+    cout << '\n';
+    pressEnterToContinue();
+}
+
+void RiwayatAktivitasMenu() {
+    clearScreen();
+    displayHeader();
+    cout << "   Riwayat aktivitas " << currentUser->nama << "\n\n";
+
+    {
+        PengukurOperasi ukur(metrikOperasi, Operasi::Riwayat);
+        lock_guard<mutex> lock(currentUser->kunci.m); // Released before waiting for Enter
+        if (currentUser->riwayat_aktivitas.isEmpty()) {
+            cout << "   Belum melakukan aktivitas apapun.\n";
+        } else {
+            string out;
+            TABEL_AKTIVITAS.appendHeader(out);
+
+            Node<Aktivitas>* current = currentUser->riwayat_aktivitas.getHead();
+            while (current != nullptr) {
+                TABEL_AKTIVITAS.appendRow(out, {LayananWaktu::tanggal(current->data.waktu), keteranganAktivitas(current->data)});
+                current = current->next;
+            }
+            cout << out;
+        }
+    }
+    cout << '\n';
+    pressEnterToContinue();
+}
+
+void NavigasiKampusMenu() {
+    clearScreen();
+    displayHeader();
+    cout << "   Navigasi Kampus\n\n";
+
+    const vector<pair<string, uint32_t>>& stasiun = petaKampus.daftarStasiun();
+    size_t n = stasiun.size();
+    for (size_t i = 0; i < n; i++) {
+        cout << "      " << i + 1 << ". > Stasiun " << stasiun[i].first << "\n";
+    }
+    cout << "      " << n + 1 << ". > Titik awal lain (nama jalan)\n";
+    cout << "      " << n + 2 << ". > Kembali\n";
+    cout << "\n   Pilih titik awal (1 - " << n + 2 << ") = ";
+
+    size_t choice = 0;
+    cin >> choice;
+    if (cin.fail()) {
+        cin.clear();
+        choice = 0;
+    }
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    string selectedStation = "";
+    if (choice >= 1 && choice <= n) {
+        selectedStation = stasiun[choice - 1].first;
+    } else if (choice == n + 1) {
+        cout << "   Nama jalan = ";
+        getline(cin, selectedStation);
+    } else if (choice == n + 2) {
+        return;
+    } else {
+        cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
+        pressEnterToContinue();
+        return;
+    }
+
+    displayRoute(selectedStation); // Call displayRoute function
+}
+
+void MetrikOperasiMenu() {
+    clearScreen();
+    displayHeader();
+    cout << "   Metrik operasi sejak program dimulai (semua sesi)\n\n";
+    cout << laporanMetrikTeks() << '\n';
+    pressEnterToContinue();
+}
+
+// ===============================================
+//           BATCH (HEADLESS) MODE
+// ===============================================
+
+// Run with: ./smartstudent --batch [file]   (reads stdin when no file is given)
+// One command per line; blank lines and lines starting with '#' are ignored:
+//   login <nim> <password>        logout
+//   register-consultation <id>    queue                   cancel-consultation
+//   move-consultation [dd-mm-yyyy]
+//   borrow <book id>              return <book id>        loans
+//   hold <book id>                holds                   hold-position <book id>
+//   search <keyword>              filter                  books
+//   recommend <book id>           history loans|activity
+//   route <station>               route <start> | <destination>          route-cache
+//   metrics
+// Each command produces exactly one JSON object on its own line (JSON Lines), calling the same
+// service functions as the menus, without clearing the screen or waiting for Enter.
+// A summary with the command count and throughput is written to stderr at the end.
+
+string jsonEscape(const string& text) {
+    string out;
+    out.reserve(text.size() + 2);
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(c));
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+string jsonBooks(const BukuView& view) {
+    string out = "\"count\":" + to_string(view.size()) + ",\"books\":[";
+    bool first = true;
+    for (size_t slot : view) {
+        const Buku& buku = daftarBuku.at(slot);
+        out += first ? "{" : ",{";
+        out += "\"id\":" + jsonEscape(buku.id) + ",\"judul\":" + jsonEscape(buku.judul);
+        out += string(",\"tersedia\":") + (daftarBuku.isTersedia(slot) ? "true" : "false") + "}";
+        first = false;
+    }
+    out += "]";
+    return out;
+}
+
+// Executes one batch command for the session's student and returns its JSON result line
+string runBatchCommand(const string& line, Mahasiswa*& sesi) {
+    size_t spasi = line.find(' ');
+    string cmd = line.substr(0, spasi);
+    string arg = spasi == string::npos ? "" : line.substr(spasi + 1);
+    string hasil = "{\"cmd\":" + jsonEscape(cmd) + ",";
+
+    auto error = [&hasil](const string& kode) { return hasil + "\"ok\":false,\"error\":" + jsonEscape(kode) + "}"; };
+
+    if (cmd == "login") {
+        istringstream in(arg);
+        string nim, password;
+        in >> nim >> password;
+        sesi = authenticate(nim, password);
+        if (sesi == nullptr) return error("invalid_credentials");
+        return hasil + "\"ok\":true,\"nim\":" + jsonEscape(sesi->nim) + ",\"nama\":" + jsonEscape(sesi->nama) + "}";
+    }
+    if (cmd == "route") { // "route <start>" to campus or "route <start> | <destination>"
+        size_t pemisah = arg.find(" | ");
+        string asal = arg.substr(0, pemisah);
+        string tujuan = pemisah == string::npos ? "" : arg.substr(pemisah + 3);
+        RuteJalan rute;
+        bool ada = tujuan.empty() ? cariRuteKampus(asal, rute) : cariRute(asal, tujuan, rute);
+        if (!ada) {
+            if (petaKampus.cariTitik(asal) == GrafJalan::TIDAK_ADA) return error("unknown_station");
+            if (!tujuan.empty() && petaKampus.cariTitik(tujuan) == GrafJalan::TIDAK_ADA) return error("unknown_destination");
+            return error("no_route");
+        }
+        hasil += "\"ok\":true,\"station\":" + jsonEscape(asal);
+        if (!tujuan.empty()) hasil += ",\"to\":" + jsonEscape(tujuan);
+        hasil += ",\"distance_m\":" + to_string(rute.meter) + ",\"steps\":[";
+        for (size_t i = 0; i < rute.titik.size(); i++) {
+            hasil += (i ? "," : "") + jsonEscape(petaKampus.namaTitik(rute.titik[i]));
+        }
+        return hasil + "]}";
+    }
+    if (cmd == "metrics") return hasil + "\"ok\":true," + jsonMetrik() + "}";
+    if (cmd == "route-cache") {
+        uint64_t hit = cacheRute.jumlahHit(), miss = cacheRute.jumlahMiss();
+        char rasio[32];
+        snprintf(rasio, sizeof(rasio), "%.4f", hit + miss > 0 ? static_cast<double>(hit) / (hit + miss) : 0.0);
+        return hasil + "\"ok\":true,\"hits\":" + to_string(hit) + ",\"misses\":" + to_string(miss) +
+               ",\"hit_rate\":" + rasio + ",\"size\":" + to_string(cacheRute.ukuran()) +
+               ",\"capacity\":" + to_string(cacheRute.batas()) + "}";
+    }
+
+    // Everything below acts on behalf of a logged-in student
+    if (sesi == nullptr) return error("not_logged_in");
+
+    if (cmd == "logout") {
+        sesi = nullptr;
+        return hasil + "\"ok\":true}";
+    }
+    bool terdaftar;
+    string dosenRujukan;
+    {
+        lock_guard<mutex> lock(sesi->kunci.m);
+        terdaftar = sesi->sudah_daftar_konsultasi;
+        dosenRujukan = sesi->dosen_konsultasi_terdaftar;
+    }
+
+    if (cmd == "register-consultation") {
+        size_t posisi = 0;
+        int64_t jadwal = 0;
+        if (dataDosen.cariAntrean(sesi->nim, posisi, jadwal) != RegistriDosen::NOT_FOUND) return error("already_registered");
+        uint32_t dosenId = daftarKonsultasi(*sesi, arg);
+        if (dosenId == RegistriDosen::NOT_FOUND) return error("unknown_mentor");
+        cariPosisiAntrean(*sesi, posisi, jadwal);
+        return hasil + "\"ok\":true,\"dosen\":" + jsonEscape(dataDosen.at(dosenId).nama) + ",\"session\":" + jsonEscape(LayananWaktu::tanggalJam(jadwal)) + "}";
+    }
+    if (cmd == "queue") {
+        PengukurOperasi ukur(metrikOperasi, Operasi::LihatAntrean);
+        size_t posisi = 0;
+        int64_t jadwal = 0;
+        uint32_t dosenId = cariPosisiAntrean(*sesi, posisi, jadwal);
+        if (dosenId == RegistriDosen::NOT_FOUND) return error("not_in_queue");
+        return hasil + "\"ok\":true,\"dosen\":" + jsonEscape(dataDosen.at(dosenId).nama) +
+               ",\"position\":" + to_string(posisi) + ",\"size\":" + to_string(dataDosen.ukuranAntrean(dosenId)) +
+               ",\"session\":" + jsonEscape(LayananWaktu::tanggalJam(jadwal)) + "}";
+    }
+    if (cmd == "cancel-consultation") {
+        if (!batalKonsultasi(*sesi)) return error("not_in_queue");
+        return hasil + "\"ok\":true}";
+    }
+    if (cmd == "move-consultation") { // "move-consultation [dd-mm-yyyy]": first free session on or after the date, else after the current one
+        size_t posisi = 0;
+        int64_t jadwal = 0;
+        int64_t dari = LayananWaktu::dariTanggal(arg);
+        if (arg.empty()) {
+            if (cariPosisiAntrean(*sesi, posisi, jadwal) == RegistriDosen::NOT_FOUND) return error("not_in_queue");
+            dari = jadwal;
+        }
+        if (dari < 0 || dari > LayananWaktu::sekarang() + MAKS_HARI_JADWAL * 86400) return error("bad_date");
+        uint32_t dosenId = pindahKonsultasi(*sesi, dari, jadwal);
+        if (dosenId == RegistriDosen::NOT_FOUND) return error("not_in_queue");
+        cariPosisiAntrean(*sesi, posisi, jadwal);
+        return hasil + "\"ok\":true,\"dosen\":" + jsonEscape(dataDosen.at(dosenId).nama) +
+               ",\"session\":" + jsonEscape(LayananWaktu::tanggalJam(jadwal)) + ",\"position\":" + to_string(posisi) + "}";
+    }
+    if (cmd == "history") {
+        PengukurOperasi ukur(metrikOperasi, Operasi::Riwayat);
+        const LinkedList<Aktivitas>* riwayat = nullptr;
+        if (arg == "loans") riwayat = &sesi->riwayat_peminjaman;
+        else if (arg == "activity") riwayat = &sesi->riwayat_aktivitas;
+        else return error("unknown_history");
+        lock_guard<mutex> lock(sesi->kunci.m);
+        hasil += "\"ok\":true,\"type\":" + jsonEscape(arg) + ",\"count\":" + to_string(riwayat->size()) + ",\"entries\":[";
+        for (Node<Aktivitas>* current = riwayat->getHead(); current != nullptr; current = current->next) {
+            const string& keterangan = riwayat == &sesi->riwayat_peminjaman ? judulAktivitas(current->data) : keteranganAktivitas(current->data);
+            hasil += current == riwayat->getHead() ? "{" : ",{";
+            hasil += "\"tanggal\":" + jsonEscape(LayananWaktu::tanggal(current->data.waktu)) + ",\"keterangan\":" + jsonEscape(keterangan) + "}";
+        }
+        return hasil + "]}";
+    }
+    if (cmd == "loans") {
+        vector<pair<size_t, RegistriPinjaman::Pinjaman>> pinjaman = pinjamanBerjalan(*sesi);
+        hasil += "\"ok\":true,\"count\":" + to_string(pinjaman.size()) + ",\"loans\":[";
+        for (size_t i = 0; i < pinjaman.size(); i++) {
+            const Buku& buku = daftarBuku.at(pinjaman[i].first);
+            const RegistriPinjaman::Pinjaman& p = pinjaman[i].second;
+            hasil += (i ? ",{" : "{") + string("\"id\":") + jsonEscape(buku.id) + ",\"judul\":" + jsonEscape(buku.judul) +
+                     ",\"borrowed\":" + jsonEscape(LayananWaktu::tanggal(p.waktuPinjam)) + ",\"due\":" + jsonEscape(LayananWaktu::tanggal(p.jatuhTempo)) +
+                     ",\"overdue\":" + (p.terlambat() ? "true" : "false") + "}";
+        }
+        return hasil + "]}";
+    }
+    if (cmd == "return") { // Any book the student holds, whichever mentor referenced it
+        size_t slot = KatalogBuku::NOT_FOUND;
+        RegistriPinjaman::Pinjaman pinjaman;
+        string penerima;
+        switch (kembalikanBuku(*sesi, arg, slot, pinjaman, penerima)) {
+            case HasilKembali::Berhasil:
+                return hasil + "\"ok\":true,\"id\":" + jsonEscape(arg) + ",\"judul\":" + jsonEscape(daftarBuku.at(slot).judul) +
+                       ",\"overdue\":" + (pinjaman.terlambat() || LayananWaktu::sekarang() > pinjaman.jatuhTempo ? "true" : "false") +
+                       ",\"handed_off\":" + (penerima.empty() ? "false" : "true") + "}";
+            case HasilKembali::TidakDipinjam:
+                return error("not_borrowed");
+            case HasilKembali::TidakDitemukan:
+                return error("book_not_found");
+        }
+    }
+    if (cmd == "holds") {
+        vector<pair<size_t, size_t>> pesanan = pesananBerjalan(*sesi);
+        hasil += "\"ok\":true,\"count\":" + to_string(pesanan.size()) + ",\"holds\":[";
+        for (size_t i = 0; i < pesanan.size(); i++) {
+            const Buku& buku = daftarBuku.at(pesanan[i].first);
+            hasil += (i ? ",{" : "{") + string("\"id\":") + jsonEscape(buku.id) + ",\"judul\":" + jsonEscape(buku.judul) +
+                     ",\"position\":" + to_string(pesanan[i].second) + "}";
+        }
+        return hasil + "]}";
+    }
+    if (cmd == "hold-position") {
+        size_t slot = daftarBuku.findSlotById(arg);
+        if (slot == KatalogBuku::NOT_FOUND) return error("book_not_found");
+        size_t posisi = antreanPesanan.posisi(static_cast<uint32_t>(slot), sesi->nim);
+        if (posisi == 0) return error("not_waiting");
+        return hasil + "\"ok\":true,\"id\":" + jsonEscape(arg) + ",\"position\":" + to_string(posisi) +
+               ",\"waiting\":" + to_string(antreanPesanan.panjang(static_cast<uint32_t>(slot))) + "}";
+    }
+
+    // Library commands require a consultation mentor, as in the main menu
+    if (cmd == "borrow" || cmd == "hold" || cmd == "search" || cmd == "filter" || cmd == "books" || cmd == "recommend") {
+        if (!terdaftar) return error("consultation_required");
+
+        if (cmd == "borrow") {
+            size_t slot = KatalogBuku::NOT_FOUND;
+            switch (pinjamBuku(*sesi, arg, dosenRujukan, slot)) {
+                case HasilPinjam::Berhasil: {
+                    RegistriPinjaman::Pinjaman pinjaman;
+                    pinjamanAktif.cari(static_cast<uint32_t>(slot), pinjaman);
+                    return hasil + "\"ok\":true,\"id\":" + jsonEscape(arg) + ",\"judul\":" + jsonEscape(daftarBuku.at(slot).judul) +
+                           ",\"due\":" + jsonEscape(LayananWaktu::tanggal(pinjaman.jatuhTempo)) + "}";
+                }
+                case HasilPinjam::TidakTersedia:
+                    return error("not_available");
+                case HasilPinjam::TidakDitemukan:
+                    return error("book_not_found");
+            }
+        }
+        if (cmd == "hold") {
+            size_t slot = KatalogBuku::NOT_FOUND;
+            size_t posisi = 0;
+            switch (pesanBuku(*sesi, arg, dosenRujukan, slot, posisi)) {
+                case HasilPesan::Berhasil:
+                    return hasil + "\"ok\":true,\"id\":" + jsonEscape(arg) + ",\"judul\":" + jsonEscape(daftarBuku.at(slot).judul) +
+                           ",\"position\":" + to_string(posisi) + "}";
+                case HasilPesan::Tersedia:
+                    return error("available");
+                case HasilPesan::SedangDipinjam:
+                    return error("already_borrowed");
+                case HasilPesan::SudahMengantre:
+                    return error("already_waiting");
+                case HasilPesan::TidakDitemukan:
+                    return error("book_not_found");
+            }
+        }
+        if (cmd == "search") return hasil + "\"ok\":true," + jsonBooks(searchBooks(arg, dosenRujukan)) + "}";
+        if (cmd == "recommend") {
+            if (daftarBuku.findSlotById(arg) == KatalogBuku::NOT_FOUND) return error("book_not_found");
+            vector<RekomendasiBuku::Skor> saran = cariRekomendasi(arg, RekomendasiBuku::TOP_K);
+            hasil += "\"ok\":true,\"id\":" + jsonEscape(arg) + ",\"count\":" + to_string(saran.size()) + ",\"books\":[";
+            for (size_t i = 0; i < saran.size(); i++) {
+                const Buku& buku = daftarBuku.at(saran[i].slot);
+                hasil += (i ? ",{" : "{") + string("\"id\":") + jsonEscape(buku.id) + ",\"judul\":" + jsonEscape(buku.judul) +
+                         ",\"co_borrows\":" + to_string(saran[i].jumlah) + "}";
+            }
+            return hasil + "]}";
+        }
+        if (cmd == "filter") return hasil + "\"ok\":true," + jsonBooks(filterAvailableBooks(dosenRujukan)) + "}";
+        return hasil + "\"ok\":true," + jsonBooks(booksByDosen(dosenRujukan)) + "}";
+    }
+    return error("unknown_command");
+}
+
+int runBatch(istream& in) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr); // Results are flushed in bulk, not before every read
+
+    Mahasiswa* sesi = nullptr;
+    size_t jumlah = 0, gagal = 0;
+    string line;
+    auto start = chrono::steady_clock::now();
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        string hasil = runBatchCommand(line, sesi);
+        if (hasil.find("\"ok\":false") != string::npos) gagal++;
+        jumlah++;
+        sinkronkanWal(); // Report a change only once it is durable (returns at once for reads)
+        cout << hasil << '\n';
+        periksaJatuhTempo(LayananWaktu::sekarang());
+        snapshotBilaPerlu();
+    }
+    cout.flush();
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cerr << "{\"summary\":true,\"commands\":" << jumlah << ",\"errors\":" << gagal
+         << ",\"elapsed_ms\":" << ms << ",\"ops_per_sec\":" << (ms > 0 ? jumlah * 1000.0 / ms : 0.0) << "}\n";
+    return 0;
+}
+
+// ===============================================
+//           SERVER MODE (UNIX SOCKET + EPOLL)
+// ===============================================
+
+// Run with: ./smartstudent --server <socket path>
+// Serves many students at once over a local Unix domain socket. Each connection speaks the batch
+// protocol (one command per line, one JSON line back) and has its own session object in place of
+// the global currentUser. A single epoll loop multiplexes all connections against the shared
+// dataMahasiswa, daftarBuku and consultation queues.
+//
+// Load client: ./smartstudent --load-client <socket path> [connections] [requests per connection]
+// Keeps one request in flight per connection and reports requests per second and latency percentiles.
+
+#ifdef __linux__
+
+// Per-connection state; the session's student replaces the global currentUser
+struct SesiKoneksi {
+    int fd;
+    Mahasiswa* mahasiswa; // Logged-in student for this connection, or nullptr
+    string masuk;         // Received bytes that do not form a full line yet
+    string keluar;        // Responses not yet written to the socket
+};
+
+volatile sig_atomic_t serverBerhenti = 0;
+
+void hentikanServer(int) {
+    serverBerhenti = 1;
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int connectUnixSocket(const string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Writes as much pending output as the socket accepts; returns false if the connection broke
+bool flushKoneksi(SesiKoneksi& sesi) {
+    size_t sent = 0;
+    while (sent < sesi.keluar.size()) {
+        ssize_t n = send(sesi.fd, sesi.keluar.data() + sent, sesi.keluar.size() - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    sesi.keluar.erase(0, sent);
+    return true;
+}
+
+const size_t BATAS_BARIS = 64 * 1024; // Longest command line a client may send
+
+// Answers every complete line received so far and keeps the unfinished rest
+void jalankanBaris(SesiKoneksi& sesi) {
+    size_t awal = 0, akhir;
+    while ((akhir = sesi.masuk.find('\n', awal)) != string::npos) {
+        string line = sesi.masuk.substr(awal, akhir - awal);
+        awal = akhir + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        sesi.keluar += runBatchCommand(line, sesi.mahasiswa);
+        sesi.keluar += '\n';
+    }
+    sesi.masuk.erase(0, awal);
+}
+
+// Reads everything available and answers every complete line; returns false when the peer is
+// gone or sends a line longer than BATAS_BARIS, so one client cannot grow the buffer without end
+bool bacaKoneksi(SesiKoneksi& sesi) {
+    char buf[16384];
+    while (true) {
+        ssize_t n = recv(sesi.fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            sesi.masuk.append(buf, static_cast<size_t>(n));
+            jalankanBaris(sesi);
+            if (sesi.masuk.size() > BATAS_BARIS) return false;
+            continue;
+        }
+        if (n == 0) return false;
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        return false;
+    }
+    return true;
+}
+
+int runServer(const string& path) {
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (listenFd < 0 || path.size() >= sizeof(addr.sun_path)) {
+        cerr << "Socket server tidak dapat dibuat.\n";
+        return 1;
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        cerr << "Gagal membuka socket " << path << ": " << strerror(errno) << "\n";
+        close(listenFd);
+        return 1;
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+
+    signal(SIGINT, hentikanServer);
+    signal(SIGTERM, hentikanServer);
+    signal(SIGPIPE, SIG_IGN);
+
+    unordered_map<int, SesiKoneksi> sesiByFd;
+    auto tutup = [&](int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        sesiByFd.erase(fd);
+    };
+
+    cerr << "Server Smart.Student mendengarkan di " << path << "\n";
+    vector<epoll_event> events(1024);
+    vector<pair<int, bool>> dilayani; // Connections read this round and whether they stay open
+    while (!serverBerhenti) {
+        // Wakes at least once a second so loans coming due are recorded while the server is idle
+        int n = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 1000);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        dilayani.clear();
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                int clientFd;
+                while ((clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    sesiByFd[clientFd] = {clientFd, nullptr, "", ""};
+                    epoll_event cev = {};
+                    cev.events = EPOLLIN | EPOLLRDHUP;
+                    cev.data.fd = clientFd;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &cev);
+                }
+                continue;
+            }
+
+            auto it = sesiByFd.find(fd);
+            if (it == sesiByFd.end()) continue;
+            SesiKoneksi& sesi = it->second;
+            bool hidup = true;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+                hidup = bacaKoneksi(sesi);
+            }
+            if (events[i].events & EPOLLERR) {
+                hidup = false;
+            }
+            dilayani.push_back({fd, hidup});
+        }
+
+        // Group commit: one WAL sync covers every change made this round, and no reply leaves
+        // before the changes it reports are durable
+        sinkronkanWal();
+        for (const auto& koneksi : dilayani) {
+            int fd = koneksi.first;
+            SesiKoneksi& sesi = sesiByFd.at(fd);
+            // Answer what was read before closing, even if the peer already half-closed
+            if (!flushKoneksi(sesi) || !koneksi.second) {
+                tutup(fd);
+                continue;
+            }
+            epoll_event mev = {};
+            mev.events = EPOLLIN | EPOLLRDHUP | (sesi.keluar.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+            mev.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &mev);
+        }
+        periksaJatuhTempo(LayananWaktu::sekarang());
+        snapshotBilaPerlu(); // Between rounds no request is half-applied
+    }
+
+    for (auto& entry : sesiByFd) {
+        close(entry.first);
+    }
+    close(epollFd);
+    close(listenFd);
+    unlink(path.c_str());
+    cerr << "Server berhenti.\n";
+    return 0;
+}
+
+// One simulated student connection of the load client
+struct KlienLoad {
+    int fd;
+    size_t terkirim;  // Requests sent
+    size_t diterima;  // Responses received
+    string masuk;
+    chrono::steady_clock::time_point waktuKirim;
+};
+
+// Request mix: log in as one of the demo students, register, then cycle through read-heavy commands
+string requestLoad(size_t koneksi, size_t ke) {
+    static const char* AKUN[][2] = {
+        {"217403", "15071999"}, {"532618", "03082002"}, {"894205", "22121997"},
+        {"670349", "09052000"}, {"356127", "17111998"}
+    };
+    static const char* CAMPURAN[] = {"queue\n", "search python\n", "filter\n", "route Blok M\n", "books\n"};
+    if (ke == 0) {
+        const char* const* akun = AKUN[koneksi % 5];
+        return string("login ") + akun[0] + " " + akun[1] + "\n";
+    }
+    if (ke == 1) return koneksi % 2 ? "register-consultation DSN2\n" : "register-consultation DSN1\n";
+    return CAMPURAN[(koneksi + ke) % 5];
+}
+
+int runLoadClient(const string& path, size_t jumlahKoneksi, size_t requestPerKoneksi) {
+    signal(SIGPIPE, SIG_IGN);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<KlienLoad> klien(jumlahKoneksi);
+    vector<double> latensiUs;
+    latensiUs.reserve(jumlahKoneksi * requestPerKoneksi);
+
+    auto kirim = [&](size_t idx) {
+        KlienLoad& k = klien[idx];
+        string req = requestLoad(idx, k.terkirim);
+        k.waktuKirim = chrono::steady_clock::now();
+        k.terkirim++;
+        return send(k.fd, req.data(), req.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(req.size());
+    };
+
+    for (size_t i = 0; i < jumlahKoneksi; i++) {
+        klien[i] = {connectUnixSocket(path), 0, 0, "", {}};
+        if (klien[i].fd < 0) {
+            cerr << "Koneksi ke-" << i << " gagal: " << strerror(errno) << "\n";
+            return 1;
+        }
+        setNonBlocking(klien[i].fd);
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.u64 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, klien[i].fd, &ev);
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t selesai = 0;
+    for (size_t i = 0; i < jumlahKoneksi; i++) {
+        if (requestPerKoneksi == 0 || !kirim(i)) selesai++;
+    }
+
+    vector<epoll_event> events(1024);
+    char buf[16384];
+    while (selesai < jumlahKoneksi) {
+        int n = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 5000);
+        if (n == 0) {
+            cerr << "Server tidak merespons.\n";
+            break;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int e = 0; e < n; e++) {
+            size_t idx = static_cast<size_t>(events[e].data.u64);
+            KlienLoad& k = klien[idx];
+            ssize_t r;
+            while ((r = recv(k.fd, buf, sizeof(buf), 0)) > 0) {
+                k.masuk.append(buf, static_cast<size_t>(r));
+            }
+            if (r == 0 && k.masuk.find('\n') == string::npos) { // Server closed the connection
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, k.fd, nullptr);
+                selesai++;
+                continue;
+            }
+            size_t pos;
+            while ((pos = k.masuk.find('\n')) != string::npos) {
+                k.masuk.erase(0, pos + 1);
+                latensiUs.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - k.waktuKirim).count());
+                k.diterima++;
+                if (k.terkirim < requestPerKoneksi) {
+                    if (!kirim(idx)) selesai++;
+                } else {
+                    selesai++;
+                }
+            }
+        }
+    }
+    double totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    for (const KlienLoad& k : klien) {
+        close(k.fd);
+    }
+    close(epollFd);
+
+    sort(latensiUs.begin(), latensiUs.end());
+    auto persentil = [&latensiUs](double p) {
+        return latensiUs.empty() ? 0.0 : latensiUs[min(latensiUs.size() - 1, static_cast<size_t>(p * latensiUs.size()))];
+    };
+    cout << "connections=" << jumlahKoneksi
+         << " requests=" << latensiUs.size()
+         << " elapsed_ms=" << fixed << setprecision(1) << totalMs
+         << " rps=" << setprecision(0) << (totalMs > 0 ? latensiUs.size() * 1000.0 / totalMs : 0.0)
+         << " p50_us=" << setprecision(1) << persentil(0.50)
+         << " p99_us=" << persentil(0.99)
+         << " max_us=" << (latensiUs.empty() ? 0.0 : latensiUs.back()) << "\n";
+    return latensiUs.size() == jumlahKoneksi * requestPerKoneksi ? 0 : 1;
+}
+
+#endif
+
+// ===============================================
+//           BENCHMARKS
+// ===============================================
+
+// Run with: ./smartstudent --bench [name|all] [--format text|csv|json] [--max N]
+// Each benchmark prints one line per measurement: name, data size, total time and cost per
+// operation (ops defaults to n when every element is one operation). With csv or json the
+// measurements are the only thing on stdout (a CSV table, or one JSON object per line) and every
+// note goes to stderr, so runs of two commits can be diffed or loaded directly. Names, sizes and
+// order depend only on the benchmark, never on timings. --max caps the data sizes of the
+// benchmarks that scale (services: 10^3 up to 10^6 by default, 10^7 with --max 10000000).
+
+enum class FormatBench { Teks, Csv, Json };
+FormatBench formatBench = FormatBench::Teks;
+size_t skalaMaksBench = 1000000;
+ostream* keluaranBench = &cout; // Measurements; cout itself carries the notes
+
+double elapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void printBenchResult(const string& name, size_t n, double totalMs, size_t ops = 0) {
+    if (ops == 0) ops = n;
+    double nsPerOp = ops ? totalMs * 1e6 / ops : 0.0;
+    ostream& out = *keluaranBench;
+    switch (formatBench) {
+        case FormatBench::Teks:
+            out << left << setw(40) << name
+                << " n=" << setw(10) << n
+                << " total_ms=" << setw(12) << fixed << setprecision(3) << totalMs
+                << " ns_per_op=" << fixed << setprecision(1) << nsPerOp << "\n";
+            break;
+        case FormatBench::Csv: // Names never contain commas or quotes
+            out << name << ',' << n << ',' << ops << ',' << fixed << setprecision(3) << totalMs << ','
+                << setprecision(1) << nsPerOp << '\n';
+            break;
+        case FormatBench::Json:
+            out << "{\"name\":" << jsonEscape(name) << ",\"n\":" << n << ",\"ops\":" << ops
+                << ",\"total_ms\":" << fixed << setprecision(3) << totalMs
+                << ",\"ns_per_op\":" << setprecision(1) << nsPerOp << "}\n";
+            break;
+    }
+    out.unsetf(ios::floatfield);
+    out.flush();
+}
+
+// While alive, screens render into nothing and every "press Enter" prompt is answered at once,
+// so UI functions can be timed without a terminal
+class TanpaTampilan {
+private:
+    struct BufferKosong : streambuf {
+        int overflow(int c) override { return c == EOF ? 0 : c; }
+        streamsize xsputn(const char*, streamsize n) override { return n; }
+    };
+    struct BufferEnter : streambuf {
+        char baris[4096];
+        BufferEnter() { memset(baris, '\n', sizeof(baris)); }
+        int underflow() override {
+            setg(baris, baris, baris + sizeof(baris));
+            return '\n';
+        }
+    };
+    BufferKosong kosong;
+    BufferEnter enter;
+    streambuf* coutAsli;
+    streambuf* cinAsli;
+
+public:
+    TanpaTampilan() : coutAsli(cout.rdbuf(&kosong)), cinAsli(cin.rdbuf(&enter)) {}
+    TanpaTampilan(const TanpaTampilan&) = delete;
+    TanpaTampilan& operator=(const TanpaTampilan&) = delete;
+    ~TanpaTampilan() {
+        cout.rdbuf(coutAsli);
+        cin.rdbuf(cinAsli);
+    }
+};
+
+// Heap bytes behind a string (0 while it fits in the small-string buffer inside the object)
+size_t heapString(const string& s) {
+    const char* objek = reinterpret_cast<const char*>(&s);
+    bool diDalam = s.data() >= objek && s.data() < objek + sizeof(s);
+    return diDalam ? 0 : s.capacity() + 1;
+}
+
+void benchLinkedList() {
+    const size_t N = 1000000; // Entries per student
+    const size_t RENDER_N = 100000;
+    size_t checksum = 0;
+    if (dataDosen.size() == 0) initializeData(); // Titles and mentor names to render
+
+    LinkedList<Aktivitas> riwayat;
+    int64_t waktu = LayananWaktu::sekarang();
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        riwayat.add({waktu, static_cast<uint32_t>(i % daftarBuku.size()), JenisAktivitas::PinjamBuku});
+    }
+    printBenchResult("linkedlist.append", N, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (Node<Aktivitas>* current = riwayat.getHead(); current != nullptr; current = current->next) {
+        checksum += current->data.ref;
+    }
+    printBenchResult("linkedlist.scan", N, elapsedMs(start));
+
+    // Text is only built for the rows a history screen shows
+    start = chrono::steady_clock::now();
+    Node<Aktivitas>* current = riwayat.getHead();
+    for (size_t i = 0; i < RENDER_N; i++, current = current->next) {
+        checksum += LayananWaktu::tanggal(current->data.waktu).size() + keteranganAktivitas(current->data).size();
+    }
+    printBenchResult("linkedlist.render_row", RENDER_N, elapsedMs(start));
+
+    // Reference: the previous <date, text> entries, with the title copied into every entry
+    LinkedList<pair<string, string>> riwayatTeks;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        riwayatTeks.add({LayananWaktu::tanggal(waktu), "Meminjam buku dengan judul \"" + daftarBuku.at(i % daftarBuku.size()).judul + "\""});
+    }
+    printBenchResult("linkedlist.append_text_entries", N, elapsedMs(start));
+
+    size_t heapTeks = 0, alokasiTeks = 0;
+    for (Node<pair<string, string>>* node = riwayatTeks.getHead(); node != nullptr; node = node->next) {
+        for (const string* teks : {&node->data.first, &node->data.second}) {
+            size_t heap = heapString(*teks);
+            heapTeks += heap;
+            alokasiTeks += heap != 0;
+        }
+    }
+    size_t bytesTyped = sizeof(Node<Aktivitas>) * N;
+    size_t bytesTeks = sizeof(Node<pair<string, string>>) * N + heapTeks;
+    cout << "   (memory at " << N << " entries, before allocator overhead:\n"
+         << "      typed records  " << sizeof(Node<Aktivitas>) << " B/entry, " << bytesTyped / (1024 * 1024)
+         << " MiB, 0 heap allocations\n"
+         << "      date + text    " << bytesTeks / N << " B/entry, " << bytesTeks / (1024 * 1024)
+         << " MiB, " << alokasiTeks << " heap allocations)\n";
+
+    // Reference: the previous head-walking add(), which is O(n) per insert
+    const size_t NAIVE_N = 20000;
+    Node<Aktivitas>* naiveHead = nullptr;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < NAIVE_N; i++) {
+        Node<Aktivitas>* newNode = new Node<Aktivitas>({waktu, 0, JenisAktivitas::PinjamBuku});
+        if (naiveHead == nullptr) {
+            naiveHead = newNode;
+        } else {
+            Node<Aktivitas>* last = naiveHead;
+            while (last->next != nullptr) last = last->next;
+            last->next = newNode;
+        }
+    }
+    printBenchResult("linkedlist.append_headwalk", NAIVE_N, elapsedMs(start));
+    while (naiveHead != nullptr) {
+        Node<Aktivitas>* next = naiveHead->next;
+        checksum += naiveHead->data.ref;
+        delete naiveHead;
+        naiveHead = next;
+    }
+
+    cout << "   (checksum " << checksum << ")\n";
+}
+
+// Date formatting: the previous per-call path (localtime_r, three to_string calls and several
+// concatenations) against the clock service, for today's date and for a year of history
+void benchClock() {
+    const size_t N = 1000000;
+    const int64_t DETIK_SETAHUN = 365 * 86400;
+    size_t checksum = 0;
+
+    auto formatLama = [](int64_t waktu) {
+        time_t now_c = static_cast<time_t>(waktu);
+        tm waktuLokal;
+#ifdef _WIN32
+        localtime_s(&waktuLokal, &now_c);
+#else
+        localtime_r(&now_c, &waktuLokal);
+#endif
+        tm* ltm = &waktuLokal;
+        string year = to_string(1900 + ltm->tm_year);
+        string month = to_string(1 + ltm->tm_mon);
+        string day = to_string(ltm->tm_mday);
+        if (month.length() == 1) month = "0" + month;
+        if (day.length() == 1) day = "0" + day;
+        return day + "-" + month + "-" + year;
+    };
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) checksum += static_cast<size_t>(LayananWaktu::sekarang() & 1);
+    printBenchResult("clock.now", N, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) checksum += formatLama(LayananWaktu::sekarang()).size();
+    printBenchResult("clock.today.uncached", N, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) checksum += LayananWaktu::tanggal(LayananWaktu::sekarang()).size();
+    printBenchResult("clock.today.cached", N, elapsedMs(start));
+
+    // History screens: entries spread over the past year, oldest first (about 2,700 per day)
+    int64_t awal = LayananWaktu::sekarang() - DETIK_SETAHUN;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) checksum += formatLama(awal + static_cast<int64_t>(i) * DETIK_SETAHUN / N).size();
+    printBenchResult("clock.history_year.uncached", N, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) checksum += LayananWaktu::tanggal(awal + static_cast<int64_t>(i) * DETIK_SETAHUN / N).size();
+    printBenchResult("clock.history_year.cached", N, elapsedMs(start));
+
+    // Server threads each format on their own cache, with no shared lock
+    const size_t JUMLAH_THREAD = 8;
+    atomic<size_t> total(0);
+    start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (size_t t = 0; t < JUMLAH_THREAD; t++) {
+        threads.emplace_back([&]() {
+            size_t lokal = 0;
+            for (size_t i = 0; i < N / JUMLAH_THREAD; i++) lokal += LayananWaktu::tanggal(LayananWaktu::sekarang()).size();
+            total += lokal;
+        });
+    }
+    for (thread& th : threads) th.join();
+    printBenchResult("clock.today.cached.threads=8", N, elapsedMs(start));
+    checksum += total;
+
+    cout << "   (checksum " << checksum << ")\n";
+}
+
+// Synthetic title: four words from a fixed vocabulary plus a volume number that keeps it unique
+string judulSintetis(mt19937& rng, size_t i) {
+    static const char* KATA[] = {
+        "Pengantar", "Dasar", "Lanjutan", "Struktur", "Data", "Algoritma", "Pemrograman", "Python",
+        "Java", "Kotlin", "Desain", "Grafis", "Basis", "Jaringan", "Sistem", "Operasi", "Keamanan",
+        "Machine", "Learning", "Statistika", "Kalkulus", "Aljabar", "Web", "Mobile", "Interaksi",
+        "Pengguna", "Tipografi", "Komputer", "Arsitektur", "Kompilator"
+    };
+    const size_t JUMLAH_KATA = sizeof(KATA) / sizeof(KATA[0]);
+    string judul;
+    for (int w = 0; w < 4; w++) {
+        judul += KATA[rng() % JUMLAH_KATA];
+        judul += ' ';
+    }
+    return judul + "Jilid " + to_string(i);
+}
+
+// Synthetic catalog: synthetic titles spread over a few mentors, inserted in title order
+vector<Buku> generateBooks(size_t n, size_t jumlahDosen, unsigned seed) {
+    mt19937 rng(seed);
+    vector<Buku> hasil;
+    hasil.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        hasil.push_back({"B" + to_string(i), judulSintetis(rng, i), "Dosen " + to_string(i % jumlahDosen)});
+    }
+    sort(hasil.begin(), hasil.end());
+    return hasil;
+}
+
+// Synthetic population for the service benchmarks, grown in place so every size builds on the
+// previous one. Codes carry an "S" prefix so they never collide with other benchmarks' data.
+// Student i: NIM "S<i>", password "pw<i>". Mentor m: code "SDSN<m>", name "Dosen S<m>".
+// Book i: ID "SB<i>", referenced by mentor i % (mentors when it was generated).
+void generateMahasiswa(size_t awal, size_t akhir) {
+    for (size_t i = awal; i < akhir; i++) {
+        string nim = "S" + to_string(i);
+        dataMahasiswa.emplace(nim, Mahasiswa(nim, "pw" + to_string(i), "Mahasiswa " + nim));
+    }
+}
+
+void generateDosen(size_t awal, size_t akhir) {
+    for (size_t m = awal; m < akhir; m++) {
+        dataDosen.add({"SDSN" + to_string(m), "Dosen S" + to_string(m), "Mata Kuliah " + to_string(m % 40)});
+    }
+}
+
+void generateBuku(size_t awal, size_t akhir, size_t jumlahDosen, unsigned seed) {
+    mt19937 rng(seed);
+    vector<Buku> hasil;
+    hasil.reserve(akhir - awal);
+    for (size_t i = awal; i < akhir; i++) {
+        hasil.push_back({"SB" + to_string(i), judulSintetis(rng, i), "Dosen S" + to_string(i % jumlahDosen)});
+    }
+    daftarBuku.muatMassal(std::move(hasil));
+}
+
+// Queues students awal..akhir-1 (one entry each) with random mentors through the service call
+void generateAntrean(size_t awal, size_t akhir, size_t jumlahDosen, unsigned seed) {
+    mt19937 rng(seed);
+    for (size_t i = awal; i < akhir; i++) {
+        Mahasiswa* mhs = cariMahasiswa("S" + to_string(i));
+        if (mhs != nullptr && !mhs->sudah_daftar_konsultasi) daftarKonsultasi(*mhs, "SDSN" + to_string(rng() % jumlahDosen));
+    }
+}
+
+// Appends `jumlah` loan entries spread over students 0..jumlahMahasiswa-1
+void generateRiwayat(size_t jumlah, size_t jumlahMahasiswa, size_t jumlahBuku, unsigned seed) {
+    mt19937 rng(seed);
+    int64_t waktu = LayananWaktu::sekarang();
+    for (size_t i = 0; i < jumlah; i++) {
+        Mahasiswa& mhs = dataMahasiswa["S" + to_string(rng() % jumlahMahasiswa)];
+        Aktivitas a{waktu - static_cast<int64_t>(rng() % 31536000), static_cast<uint32_t>(rng() % jumlahBuku), JenisAktivitas::PinjamBuku};
+        mhs.riwayat_peminjaman.add(a);
+        mhs.riwayat_aktivitas.add(a);
+    }
+}
+
+// Synthetic city: a lebar x lebar street grid, segments of 80-200 m, about 5% of them closed
+void generateGrid(GrafJalan& peta, size_t lebar, unsigned seed) {
+    mt19937 rng(seed);
+    for (size_t r = 0; r < lebar; r++) {
+        for (size_t c = 0; c < lebar; c++) peta.tambahTitik("Jl. " + to_string(r) + "/" + to_string(c));
+    }
+    for (size_t r = 0; r < lebar; r++) {
+        for (size_t c = 0; c < lebar; c++) {
+            uint32_t v = static_cast<uint32_t>(r * lebar + c);
+            if (c + 1 < lebar && rng() % 20 != 0) peta.tambahJalan(v, v + 1, 80 + rng() % 121);
+            if (r + 1 < lebar && rng() % 20 != 0) peta.tambahJalan(v, static_cast<uint32_t>(v + lebar), 80 + rng() % 121);
+        }
+    }
+}
+
+// Route queries between random points: plain Dijkstra against the contraction hierarchy, with
+// p50/p99 latency per query and a check that both return the same distances. Then routes to the
+// nearest of three campus buildings (a search per building vs. the precomputed trees) and the
+// route cache under skewed traffic (a few pairs asked often), with its hit rate per capacity.
+void benchRouting() {
+    const size_t KUERI = 2000;
+    const size_t KUERI_DIJKSTRA = 100;
+    const size_t KUERI_CACHE = 20000;
+    const size_t PASANGAN_CACHE = 20000; // Distinct pairs in the skewed traffic
+
+    for (size_t lebar : {50, 158, 500}) {
+        GrafJalan peta;
+        generateGrid(peta, lebar, 17);
+        size_t tengah = lebar / 2;
+        for (size_t sel : {tengah * lebar + tengah, tengah, (lebar - 1) * lebar}) { // Center, top edge, a corner
+            peta.tandaiKampus(static_cast<uint32_t>(sel));
+        }
+        auto start = chrono::steady_clock::now();
+        peta.bangunIndeks();
+        string label = ".arcs=" + to_string(peta.jumlahBusur());
+        printBenchResult("routing.ch_build" + label, peta.jumlahTitik(), elapsedMs(start));
+        cout << "   (" << peta.jumlahTitik() << " nodes, " << peta.jumlahBusurNaik() << " upward arcs incl. shortcuts)\n";
+
+        mt19937 rng(99);
+        vector<pair<uint32_t, uint32_t>> pasangan(KUERI);
+        for (auto& p : pasangan) {
+            p.first = static_cast<uint32_t>(rng() % peta.jumlahTitik());
+            p.second = static_cast<uint32_t>(rng() % peta.jumlahTitik());
+        }
+
+        vector<uint32_t> referensi(KUERI_DIJKSTRA);
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < KUERI_DIJKSTRA; i++) {
+            referensi[i] = peta.cariJalurDijkstra(pasangan[i].first, pasangan[i].second);
+        }
+        printBenchResult("routing.dijkstra" + label, KUERI_DIJKSTRA, elapsedMs(start));
+
+        size_t beda = 0, checksum = 0;
+        vector<uint32_t> jalur;
+        for (bool denganJalur : {false, true}) {
+            vector<double> latensi(KUERI);
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < KUERI; i++) {
+                auto mulai = chrono::steady_clock::now();
+                uint32_t meter = peta.cariJalur(pasangan[i].first, pasangan[i].second, denganJalur ? &jalur : nullptr);
+                latensi[i] = elapsedMs(mulai) * 1000.0;
+                if (i < KUERI_DIJKSTRA && meter != referensi[i]) beda++;
+                checksum += meter != GrafJalan::TAK_HINGGA ? meter : 0;
+                if (denganJalur && meter != GrafJalan::TAK_HINGGA) {
+                    uint32_t total = 0; // The unpacked path must be made of real segments adding up
+                    for (size_t j = 1; j < jalur.size(); j++) total += peta.panjangRuas(jalur[j - 1], jalur[j]);
+                    beda += total != meter;
+                }
+            }
+            printBenchResult(string(denganJalur ? "routing.ch_query_path" : "routing.ch_query") + label, KUERI, elapsedMs(start));
+            sort(latensi.begin(), latensi.end());
+            cout << "   (p50 " << fixed << setprecision(1) << latensi[KUERI / 2] << " us, p99 "
+                 << latensi[KUERI * 99 / 100] << " us)\n";
+            cout.unsetf(ios::floatfield);
+        }
+
+        vector<uint32_t> referensiKampus(KUERI);
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < KUERI; i++) {
+            uint32_t terpendek = GrafJalan::TAK_HINGGA;
+            for (uint32_t kampus : peta.daftarKampus()) {
+                terpendek = min(terpendek, peta.cariJalur(pasangan[i].first, kampus, &jalur));
+            }
+            referensiKampus[i] = terpendek;
+        }
+        printBenchResult("routing.campus_ch" + label, KUERI, elapsedMs(start));
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < KUERI; i++) {
+            uint32_t meter = peta.cariJalurKampus(pasangan[i].first, &jalur);
+            beda += meter != referensiKampus[i];
+            checksum += jalur.size();
+        }
+        printBenchResult("routing.campus_tree" + label, KUERI, elapsedMs(start));
+        cout << "   (" << beda << " mismatches, checksum " << checksum << ")\n";
+
+        vector<pair<uint32_t, uint32_t>> daftarPasangan(PASANGAN_CACHE);
+        for (auto& p : daftarPasangan) {
+            p.first = static_cast<uint32_t>(rng() % peta.jumlahTitik());
+            p.second = static_cast<uint32_t>(rng() % peta.jumlahTitik());
+        }
+        uniform_real_distribution<double> acak(0.0, 1.0);
+        vector<uint32_t> lalulintas(KUERI_CACHE); // u^4 puts most requests on the first few pairs
+        for (uint32_t& idx : lalulintas) {
+            double u = acak(rng);
+            idx = static_cast<uint32_t>(u * u * u * u * PASANGAN_CACHE);
+        }
+        for (size_t kapasitas : {256, 4096}) {
+            CacheRute cache(kapasitas);
+            RuteJalan rute;
+            start = chrono::steady_clock::now();
+            for (uint32_t idx : lalulintas) {
+                const pair<uint32_t, uint32_t>& p = daftarPasangan[idx];
+                if (!cache.ambil(p.first, p.second, rute)) {
+                    rute.meter = peta.cariJalur(p.first, p.second, &rute.titik);
+                    cache.simpan(p.first, p.second, rute);
+                }
+                checksum += rute.meter != GrafJalan::TAK_HINGGA ? rute.meter : 0;
+            }
+            printBenchResult("routing.lru[" + to_string(kapasitas) + "]" + label, KUERI_CACHE, elapsedMs(start));
+            cout << "   (hit rate " << fixed << setprecision(1)
+                 << 100.0 * cache.jumlahHit() / (cache.jumlahHit() + cache.jumlahMiss()) << "%, "
+                 << cache.ukuran() << " routes cached)\n";
+            cout.unsetf(ios::floatfield);
+        }
+    }
+}
+
+void benchSearch() {
+    const char* QUERIES[] = {"python", "desain grafis", "jilid 4242", "zzz"};
+    const size_t QUERY_REPEAT = 5;
+    size_t checksum = 0;
+
+    for (size_t n : {1000, 10000, 100000, 1000000}) {
+        KatalogBuku katalog;
+        for (const Buku& b : generateBooks(n, 4, 42)) {
+            katalog.insert(b);
+        }
+
+        for (const char* query : QUERIES) {
+            auto start = chrono::steady_clock::now();
+            for (size_t r = 0; r < QUERY_REPEAT; r++) {
+                checksum += katalog.cariJudul(query, "Dosen 0").size();
+            }
+            printBenchResult("search.trigram[" + string(query) + "]", n, elapsedMs(start), QUERY_REPEAT);
+
+            // Reference: the previous per-query lowercase + find over every book of the mentor
+            start = chrono::steady_clock::now();
+            for (size_t r = 0; r < QUERY_REPEAT; r++) {
+                string keywordLower = KatalogBuku::toLowerCopy(query);
+                for (size_t slot : katalog.slotsByDosen("Dosen 0")) {
+                    checksum += KatalogBuku::toLowerCopy(katalog.at(slot).judul).find(keywordLower) != string::npos;
+                }
+            }
+            printBenchResult("search.scan[" + string(query) + "]", n, elapsedMs(start), QUERY_REPEAT);
+        }
+    }
+    cout << "   (checksum " << checksum << ")\n";
+}
+
+// Co-borrow recommendations: 10^6 borrow events from 10^5 students who mostly borrow within one
+// of 1,000 topics, on catalogs of 10^4 to 10^6 books. The update per event and the top-k query
+// should stay flat as the catalog grows; the maintained top-k is checked against a scan of the row.
+void benchRecommend() {
+    const size_t EVENT = 1000000;
+    const size_t MAHASISWA = 100000;
+    const size_t TOPIK = 1000;
+    const size_t KUERI = 100000;
+    size_t checksum = 0;
+
+    for (size_t jumlahBuku : {10000, 100000, 1000000}) {
+        mt19937 rng(7);
+        uniform_real_distribution<double> acak(0.0, 1.0);
+        size_t perTopik = jumlahBuku / TOPIK;
+        vector<uint32_t> topik(MAHASISWA);
+        for (uint32_t& t : topik) t = static_cast<uint32_t>(rng() % TOPIK);
+        vector<pair<uint32_t, uint32_t>> event(EVENT); // (student, book slot)
+        for (auto& e : event) {
+            e.first = static_cast<uint32_t>(rng() % MAHASISWA);
+            if (rng() % 10 == 0) { // Now and then a book from anywhere
+                e.second = static_cast<uint32_t>(rng() % jumlahBuku);
+            } else { // Popular books of the topic first
+                double u = acak(rng);
+                e.second = static_cast<uint32_t>(topik[e.first] * perTopik + static_cast<size_t>(u * u * perTopik));
+            }
+        }
+
+        unique_ptr<RekomendasiBuku> rekomendasi(new RekomendasiBuku());
+        vector<vector<uint32_t>> jendela(MAHASISWA);
+        vector<uint32_t> sebelumnya;
+        string label = ".books=" + to_string(jumlahBuku);
+        auto start = chrono::steady_clock::now();
+        for (const auto& e : event) {
+            sebelumnya = jendela[e.first];
+            if (!RekomendasiBuku::geserJendela(jendela[e.first], e.second)) sebelumnya.clear();
+            rekomendasi->catat(e.second, sebelumnya);
+        }
+        printBenchResult("recommend.update" + label, EVENT, elapsedMs(start));
+        cout << "   (" << rekomendasi->jumlahBaris() << " rows, " << rekomendasi->jumlahPasangan() << " nonzero counts)\n";
+
+        vector<uint32_t> kueri(KUERI);
+        for (uint32_t& slot : kueri) slot = event[rng() % EVENT].second;
+        vector<size_t> panjang(KUERI);
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < KUERI; i++) {
+            vector<RekomendasiBuku::Skor> top = rekomendasi->teratas(kueri[i]);
+            panjang[i] = top.size();
+            if (!top.empty()) checksum += top[0].jumlah;
+        }
+        printBenchResult("recommend.top_k" + label, KUERI, elapsedMs(start));
+
+        size_t beda = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < KUERI; i++) {
+            vector<RekomendasiBuku::Skor> scan = rekomendasi->teratasScan(kueri[i]);
+            vector<RekomendasiBuku::Skor> top = rekomendasi->teratas(kueri[i]);
+            beda += scan.size() != panjang[i];
+            for (size_t j = 0; j < min(scan.size(), top.size()); j++) beda += scan[j].jumlah != top[j].jumlah; // Ties may differ in order
+        }
+        printBenchResult("recommend.row_scan" + label, KUERI, elapsedMs(start));
+        cout << "   (" << beda << " mismatches, checksum " << checksum << ")\n";
+    }
+}
+
+// Instrumentation cost: a timed empty operation on 1 and 8 threads (two clock reads plus the
+// histogram update) against the two clock reads alone, the cost of merging all shards for a read,
+// and the percentile error of the histogram against exact sorted latencies
+void benchMetrics() {
+    const size_t N = 10000000;
+    const size_t THREADS = 8;
+    const size_t BACA = 1000;
+
+    uint64_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        auto a = chrono::steady_clock::now();
+        checksum += static_cast<uint64_t>((chrono::steady_clock::now() - a).count());
+    }
+    printBenchResult("metrics.clock_pair", N, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        PengukurOperasi ukur(metrikOperasi, Operasi::CariBuku);
+    }
+    printBenchResult("metrics.record.threads=1", N, elapsedMs(start));
+
+    vector<thread> pekerja;
+    start = chrono::steady_clock::now();
+    for (size_t t = 0; t < THREADS; t++) {
+        pekerja.emplace_back([] {
+            for (size_t i = 0; i < N / THREADS; i++) {
+                PengukurOperasi ukur(metrikOperasi, Operasi::FilterBuku);
+            }
+        });
+    }
+    for (thread& t : pekerja) t.join();
+    printBenchResult("metrics.record.threads=" + to_string(THREADS), N, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < BACA; i++) {
+        checksum += metrikOperasi.baca(static_cast<Operasi>(i % MetrikOperasi::JUMLAH_OPERASI)).jumlah;
+    }
+    printBenchResult("metrics.read.shards=" + to_string(metrikOperasi.jumlahShard()), BACA, elapsedMs(start));
+
+    // Log-normal latencies around 20 us with a long tail
+    mt19937 rng(5);
+    lognormal_distribution<double> latensi(10.0, 1.5);
+    vector<uint64_t> nilai(1000000);
+    MetrikOperasi::Ringkasan r;
+    for (uint64_t& v : nilai) {
+        v = static_cast<uint64_t>(latensi(rng)) + 1;
+        r.bucket[MetrikOperasi::indeksBucket(v)]++;
+        r.jumlah++;
+        r.maksNs = max(r.maksNs, v);
+    }
+    sort(nilai.begin(), nilai.end());
+    double galatMaks = 0;
+    for (double p : {50.0, 90.0, 99.0, 99.9}) {
+        uint64_t tepat = nilai[static_cast<size_t>(p / 100.0 * nilai.size()) - 1];
+        uint64_t terbaca = r.persentil(p);
+        galatMaks = max(galatMaks, static_cast<double>(terbaca > tepat ? terbaca - tepat : tepat - terbaca) / tepat);
+    }
+    cout << "   (histogram percentile error " << fixed << setprecision(2) << galatMaks * 100 << "%, "
+         << MetrikOperasi::JUMLAH_BUCKET << " buckets per operation, checksum " << checksum << ")\n";
+    cout.unsetf(ios::floatfield);
+}
+
+// The service and UI functions on synthetic data of 10^3 items up to --max (students, books and
+// history entries; n / 1000 mentors, at least 10; the first tenth of the students queued), with
+// rendering disabled. Every function runs OPS times per size on seeded inputs; routes run on a
+// street grid of up to 10^5 nodes.
+void benchServices() {
+    const size_t OPS = 20000;
+    const size_t TITIK_MAKS = 100000;
+    const char* KEYWORDS[] = {"python", "jilid 42", "zzz"};
+    size_t dosenAda = 0, lebarGrid = 0, n0 = 0;
+
+    for (size_t n = 1000; n <= skalaMaksBench; n *= 10) {
+        string label = ".n=" + to_string(n);
+        size_t jumlahDosen = max<size_t>(10, n / 1000);
+        auto start = chrono::steady_clock::now();
+        generateDosen(dosenAda, jumlahDosen);
+        generateMahasiswa(n0, n);
+        generateBuku(n0, n, jumlahDosen, static_cast<unsigned>(n));
+        generateAntrean(n0 / 10, n / 10, jumlahDosen, static_cast<unsigned>(n) + 1);
+        generateRiwayat(n - n0, n, daftarBuku.size(), static_cast<unsigned>(n) + 2);
+        printBenchResult("services.generate" + label, n, elapsedMs(start));
+        dosenAda = max(dosenAda, jumlahDosen);
+        n0 = n;
+
+        mt19937 rng(static_cast<unsigned>(n) + 3);
+        vector<string> nim(OPS), password(OPS), dosen(OPS), antre(OPS), bukuPinjam(OPS);
+        vector<Mahasiswa*> peminjam(OPS);
+        for (size_t i = 0; i < OPS; i++) {
+            size_t m = rng() % n;
+            nim[i] = "S" + to_string(m);
+            password[i] = "pw" + to_string(m);
+            dosen[i] = "Dosen S" + to_string(rng() % jumlahDosen);
+            antre[i] = "S" + to_string(rng() % (n / 10));
+            peminjam[i] = cariMahasiswa(antre[i]);
+            const vector<size_t>& milikDosen = daftarBuku.slotsByDosen(peminjam[i]->dosen_konsultasi_terdaftar);
+            bukuPinjam[i] = milikDosen.empty() ? "" : daftarBuku.at(milikDosen[rng() % milikDosen.size()]).id;
+        }
+
+        size_t checksum = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < OPS; i++) {
+            loginUser(nim[i], password[i]);
+            checksum += currentUser != nullptr;
+        }
+        printBenchResult("services.loginUser" + label, n, elapsedMs(start), OPS);
+
+        for (const char* keyword : KEYWORDS) {
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < OPS; i++) checksum += searchBooks(keyword, dosen[i]).size();
+            printBenchResult("services.searchBooks[" + string(keyword) + "]" + label, n, elapsedMs(start), OPS);
+        }
+
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < OPS; i++) checksum += filterAvailableBooks(dosen[i]).size();
+        printBenchResult("services.filterAvailableBooks" + label, n, elapsedMs(start), OPS);
+
+        {
+            TanpaTampilan senyap;
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < OPS; i++) displayDetailedConsultationQueue(antre[i]);
+        }
+        printBenchResult("services.displayDetailedConsultationQueue" + label, n, elapsedMs(start), OPS);
+
+        // Each book goes back untimed after its borrow, so every iteration measures the same
+        // successful path instead of piling up loans until only "unavailable" is left
+        double msPinjam = 0;
+        size_t berhasilPinjam = 0;
+        {
+            TanpaTampilan senyap;
+            size_t slot;
+            RegistriPinjaman::Pinjaman pinjaman;
+            string penerima;
+            for (size_t i = 0; i < OPS; i++) {
+                currentUser = peminjam[i];
+                start = chrono::steady_clock::now();
+                borrowBook(bukuPinjam[i], peminjam[i]->dosen_konsultasi_terdaftar);
+                msPinjam += elapsedMs(start);
+                if (kembalikanBuku(*peminjam[i], bukuPinjam[i], slot, pinjaman, penerima) == HasilKembali::Berhasil) berhasilPinjam++;
+            }
+        }
+        printBenchResult("services.borrowBook" + label, n, msPinjam, OPS);
+        cout << "   (" << berhasilPinjam << " of " << OPS << " borrows succeeded, each returned untimed before the next)\n";
+        currentUser = nullptr;
+
+        Aktivitas entri{LayananWaktu::sekarang(), 0, JenisAktivitas::PinjamBuku};
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < OPS; i++) peminjam[i]->riwayat_aktivitas.add(entri);
+        printBenchResult("services.LinkedList::add" + label, n, elapsedMs(start), OPS);
+
+        size_t lebar = 1;
+        while ((lebar + 1) * (lebar + 1) <= min(n, TITIK_MAKS)) lebar++;
+        if (lebar != lebarGrid) {
+            GrafJalan peta;
+            generateGrid(peta, lebar, 17);
+            peta.tandaiKampus(static_cast<uint32_t>(lebar / 2 * lebar + lebar / 2));
+            peta.bangunIndeks();
+            petaKampus = std::move(peta);
+            lebarGrid = lebar;
+        }
+        vector<string> asal(OPS);
+        for (string& a : asal) a = petaKampus.namaTitik(static_cast<uint32_t>(rng() % petaKampus.jumlahTitik()));
+        {
+            TanpaTampilan senyap;
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < OPS; i++) displayRoute(asal[i]);
+        }
+        printBenchResult("services.displayRoute.nodes=" + to_string(lebar * lebar) + label, n, elapsedMs(start), OPS);
+        cout << "   (checksum " << checksum << ")\n";
+    }
+}
+
+// Loan due dates: 10^5 to 10^7 timers due within four weeks on one timing wheel (schedule, cancel
+// half as returns, then advance hour by hour over 30 days) vs. an hourly scan of every loan, and
+// the sharded loan registry end to end at 10^6 loans
+void benchLoans() {
+    const int64_t JAM = 3600;
+    const int64_t RENTANG = 28 * 86400;
+    const size_t LANGKAH = 30 * 24;
+
+    for (size_t n : {100000, 1000000, 10000000}) {
+        mt19937 rng(static_cast<unsigned>(n));
+        int64_t mulai = LayananWaktu::sekarang();
+        vector<int64_t> jatuhTempo(n);
+        for (int64_t& w : jatuhTempo) w = mulai + static_cast<int64_t>(rng() % RENTANG);
+
+        RodaWaktu roda(mulai);
+        vector<uint32_t> timer(n);
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) timer[i] = roda.jadwalkan(static_cast<uint32_t>(i), jatuhTempo[i]);
+        printBenchResult("loans.wheel.schedule.n=" + to_string(n), n, elapsedMs(start));
+
+        vector<bool> kembali(n, false);
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i += 2) {
+            roda.batalkan(timer[i]);
+            kembali[i] = true;
+        }
+        printBenchResult("loans.wheel.cancel.n=" + to_string(n), n / 2, elapsedMs(start));
+
+        size_t jatuh = 0;
+        start = chrono::steady_clock::now();
+        for (size_t j = 1; j <= LANGKAH; j++) {
+            roda.maju(mulai + static_cast<int64_t>(j) * JAM, [&jatuh](uint32_t, int64_t) { jatuh++; });
+        }
+        printBenchResult("loans.wheel.expire_30d_hourly.n=" + to_string(n), n, elapsedMs(start), jatuh);
+
+        if (n <= 1000000) {
+            // Baseline: each hourly check walks every loan that has not been reported yet
+            vector<bool> dilaporkan = kembali;
+            size_t jatuhScan = 0;
+            start = chrono::steady_clock::now();
+            for (size_t j = 1; j <= LANGKAH; j++) {
+                int64_t batas = mulai + static_cast<int64_t>(j) * JAM;
+                for (size_t i = 0; i < n; i++) {
+                    if (!dilaporkan[i] && jatuhTempo[i] <= batas) {
+                        dilaporkan[i] = true;
+                        jatuhScan++;
+                    }
+                }
+            }
+            printBenchResult("loans.scan.expire_30d_hourly.n=" + to_string(n), n, elapsedMs(start), jatuhScan);
+            cout << "   (" << jatuh << " overdue on the wheel, " << jatuhScan << " by scanning)\n";
+        }
+    }
+
+    const size_t N = 1000000;
+    RegistriPinjaman registri;
+    mt19937 rng(11);
+    int64_t mulai = LayananWaktu::sekarang();
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        registri.catat(static_cast<uint32_t>(i), "S" + to_string(i % 100000), mulai, mulai + static_cast<int64_t>(rng() % RENTANG));
+    }
+    printBenchResult("loans.registry.borrow.n=" + to_string(N), N, elapsedMs(start));
+    RegistriPinjaman::Pinjaman pinjaman;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i += 2) registri.akhiri(static_cast<uint32_t>(i), "S" + to_string(i % 100000), pinjaman);
+    printBenchResult("loans.registry.return.n=" + to_string(N), N / 2, elapsedMs(start));
+    vector<RegistriPinjaman::Jatuh> jatuh;
+    start = chrono::steady_clock::now();
+    for (size_t j = 1; j <= LANGKAH; j++) registri.periksa(mulai + static_cast<int64_t>(j) * JAM, jatuh);
+    printBenchResult("loans.registry.check_30d_hourly.n=" + to_string(N), N, elapsedMs(start), jatuh.size());
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < 100000; i++) registri.periksa(mulai + static_cast<int64_t>(LANGKAH) * JAM, jatuh);
+    printBenchResult("loans.registry.check_idle", 100000, elapsedMs(start));
+}
+
+void benchHolds() {
+    const size_t JUMLAH_BUKU = 1000;
+    const size_t SAMPEL_LIST = 10000;
+
+    KatalogBuku katalog;
+    vector<Buku> buku(JUMLAH_BUKU);
+    for (size_t i = 0; i < JUMLAH_BUKU; i++) buku[i] = {"H" + to_string(i), "Buku Antrean " + to_string(i), "DSN1"};
+    katalog.muatMassal(std::move(buku), vector<bool>(JUMLAH_BUKU, false)); // Every copy is out on loan
+
+    for (size_t n : {100000, 1000000, 4000000}) {
+        vector<string> nim(n / JUMLAH_BUKU);
+        for (size_t i = 0; i < nim.size(); i++) nim[i] = "S" + to_string(i);
+        int64_t waktu = LayananWaktu::sekarang();
+        mt19937 rng(static_cast<unsigned>(n));
+
+        AntreanPesanan antrean;
+        size_t posisi = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            antrean.tambah(static_cast<uint32_t>(i % JUMLAH_BUKU), nim[i / JUMLAH_BUKU], waktu, katalog, posisi);
+        }
+        printBenchResult("holds.pool.enqueue.n=" + to_string(n), n, elapsedMs(start));
+        cout << "   (" << antrean.byteTerpakai() / n << " bytes per hold in pools and indexes, "
+             << sizeof(AntreanPesanan::Pesanan) << "-byte nodes)\n";
+
+        size_t total = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            total += antrean.posisi(static_cast<uint32_t>(rng() % JUMLAH_BUKU), nim[rng() % nim.size()]);
+        }
+        printBenchResult("holds.pool.position.n=" + to_string(n), n, elapsedMs(start));
+
+        if (n <= 1000000) {
+            // Baseline: one std::list per book, walked from the front to find a student's place
+            vector<list<string>> daftar(JUMLAH_BUKU);
+            for (size_t i = 0; i < n; i++) daftar[i % JUMLAH_BUKU].push_back(nim[i / JUMLAH_BUKU]);
+            size_t totalList = 0;
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < SAMPEL_LIST; i++) {
+                const list<string>& baris = daftar[rng() % JUMLAH_BUKU];
+                const string& dicari = nim[rng() % nim.size()];
+                size_t p = 1;
+                for (auto it = baris.begin(); it != baris.end() && *it != dicari; ++it) p++;
+                totalList += p;
+            }
+            printBenchResult("holds.list.position.n=" + to_string(n), SAMPEL_LIST, elapsedMs(start));
+            cout << "   (mean position " << total / n << " in the pool, " << totalList / SAMPEL_LIST << " walking the lists)\n";
+        }
+
+        // Every copy comes back once per hold: each return hands the book to the next in line
+        AntreanPesanan::Pesanan pesanan;
+        size_t diserahkan = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            if (antrean.serahkanAtauKembalikan(static_cast<uint32_t>(i % JUMLAH_BUKU), katalog, pesanan)) diserahkan++;
+        }
+        printBenchResult("holds.pool.handoff.n=" + to_string(n), n, elapsedMs(start));
+        if (diserahkan != n) cout << "   (" << n - diserahkan << " returns found an empty line)\n";
+
+        // A second wave reuses the released nodes: no new chunks once the pools are warm
+        size_t byteSebelum = antrean.byteTerpakai();
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            antrean.tambah(static_cast<uint32_t>(i % JUMLAH_BUKU), nim[i / JUMLAH_BUKU], waktu, katalog, posisi);
+        }
+        printBenchResult("holds.pool.reenqueue.n=" + to_string(n), n, elapsedMs(start));
+        cout << "   (pool and index bytes " << byteSebelum << " before, " << antrean.byteTerpakai() << " after the second wave)\n";
+    }
+}
+
+void benchScanKernel() {
+    const size_t N = 1000000;
+    const char* QUERIES[] = {"a", "py", "jilid 99999", "zzz"};
+    const size_t QUERY_REPEAT = 5;
+    size_t checksum = 0;
+
+    KatalogBuku katalog;
+    for (const Buku& b : generateBooks(N, 4, 42)) {
+        katalog.insert(b);
+    }
+
+    string namaTerbaik;
+    selectSubstringKernel(&namaTerbaik);
+    vector<pair<string, SubstringKernel>> kernels = {{"scalar", findSubstringScalar}};
+#ifdef SMARTSTUDENT_X86_KERNELS
+    kernels.push_back({"sse2", findSubstringSse2});
+    if (namaTerbaik == "avx2") kernels.push_back({"avx2", findSubstringAvx2});
+#endif
+    cout << "   (runtime dispatch picks " << namaTerbaik << ")\n";
+
+    for (const char* query : QUERIES) {
+        for (const auto& k : kernels) {
+            katalog.setKernel(k.second);
+            auto start = chrono::steady_clock::now();
+            for (size_t r = 0; r < QUERY_REPEAT; r++) {
+                checksum += katalog.scanJudul(query).size();
+            }
+            printBenchResult("scan." + k.first + "[" + string(query) + "]", N, elapsedMs(start), QUERY_REPEAT);
+        }
+
+        // Reference: lowercase copy + string::find for every title
+        auto start = chrono::steady_clock::now();
+        for (size_t r = 0; r < QUERY_REPEAT; r++) {
+            string keywordLower = KatalogBuku::toLowerCopy(query);
+            for (size_t slot = 0; slot < katalog.size(); slot++) {
+                checksum += KatalogBuku::toLowerCopy(katalog.at(slot).judul).find(keywordLower) != string::npos;
+            }
+        }
+        printBenchResult("scan.transform_find[" + string(query) + "]", N, elapsedMs(start), QUERY_REPEAT);
+    }
+    cout << "   (checksum " << checksum << ")\n";
+}
+
+// Stress test: 1,000 mentors, 1M consultation requests booked into their earliest free sessions,
+// then position lookups, cancellations, moves, rebooking into the freed seats and every dequeue
+// through the registry. Then the schedule tree alone against a schedule that scans its sessions.
+void benchMentorQueues() {
+    const size_t JUMLAH_DOSEN = 1000;
+    const size_t N = 1000000;
+    const size_t N_UBAH = N / 10;
+    size_t checksum = 0;
+
+    RegistriDosen registri;
+    for (size_t d = 0; d < JUMLAH_DOSEN; d++) {
+        registri.add({"DSN" + to_string(d), "Dosen " + to_string(d), "Mata Kuliah " + to_string(d)});
+    }
+
+    mt19937 rng(7);
+    vector<string> nims(N);
+    vector<uint32_t> dosenUntuk(N);
+    for (size_t i = 0; i < N; i++) {
+        nims[i] = to_string(100000000 + i);
+        dosenUntuk[i] = static_cast<uint32_t>(rng() % JUMLAH_DOSEN);
+    }
+    int64_t mulai = LayananWaktu::sekarang();
+    Konsultasi k;
+    k.nama_mahasiswa = "Mahasiswa";
+    k.tanggal_daftar = LayananWaktu::tanggal(mulai);
+
+    int64_t jadwalTerakhir = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        k.nim_mahasiswa = nims[i];
+        k.nama_dosen = registri.at(dosenUntuk[i]).nama;
+        jadwalTerakhir = max(jadwalTerakhir, registri.daftar(dosenUntuk[i], k, mulai));
+    }
+    printBenchResult("mentors.register", N, elapsedMs(start));
+    cout << "   (last session " << (jadwalTerakhir - mulai) / 86400 << " days ahead)\n";
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        size_t posisi = 0;
+        int64_t jadwal = 0;
+        checksum += registri.cariAntrean(nims[i], posisi, jadwal) + posisi;
+    }
+    printBenchResult("mentors.position", N, elapsedMs(start));
+
+    vector<size_t> acak(N);
+    for (size_t i = 0; i < N; i++) acak[i] = i;
+    shuffle(acak.begin(), acak.end(), rng);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N_UBAH; i++) checksum += registri.batal(nims[acak[i]]);
+    printBenchResult("mentors.cancel", N_UBAH, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = N_UBAH; i < 2 * N_UBAH; i++) {
+        int64_t jadwal = 0;
+        checksum += registri.pindah(nims[acak[i]], mulai + static_cast<int64_t>(rng() % 30) * 86400, jadwal);
+    }
+    printBenchResult("mentors.move", N_UBAH, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N_UBAH; i++) {
+        k.nim_mahasiswa = nims[acak[i]];
+        k.nama_dosen = registri.at(dosenUntuk[acak[i]]).nama;
+        checksum += static_cast<size_t>(registri.daftar(dosenUntuk[acak[i]], k, mulai) - mulai); // Lands in a freed seat
+    }
+    printBenchResult("mentors.rebook", N_UBAH, elapsedMs(start));
+
+    start = chrono::steady_clock::now();
+    size_t dequeued = 0;
+    for (uint32_t d = 0; d < JUMLAH_DOSEN; d++) {
+        while (registri.selesai(d)) dequeued++;
+    }
+    printBenchResult("mentors.dequeue", dequeued, elapsedMs(start));
+
+    // Tree vs. scan on the schedules alone (no registry, locks or NIM shards), booking the same
+    // requests from the same start. The scan keeps the same per-session booking lists and NIM
+    // index but walks the sessions from the first one for a free seat. With 1,000 mentors each
+    // schedule is only days deep, so the walk is short; one mentor taking 10^5 requests shows
+    // how it grows with the schedule.
+    PolaJadwal pola;
+    size_t sesiSeminggu = 7 * pola.sesi.size();
+    vector<uint32_t> kapasitas(sesiSeminggu);
+    int64_t hariMulai = JadwalKonsultasi::hariDari(mulai);
+    for (size_t i = 0; i < kapasitas.size(); i++) {
+        int hariMinggu = static_cast<int>(((hariMulai + static_cast<int64_t>(i / pola.sesi.size()) + 3) % 7 + 7) % 7);
+        kapasitas[i] = (pola.hari >> hariMinggu) & 1 ? pola.sesi[i % pola.sesi.size()].kapasitas : 0;
+    }
+    struct JadwalScan {
+        vector<vector<Konsultasi>> isi;
+        unordered_map<string, size_t> sesiByNim;
+    };
+    for (size_t jumlahDosen : {JUMLAH_DOSEN, size_t(1)}) {
+        size_t n = jumlahDosen == 1 ? N / 10 : N;
+        string label = ".mentors=" + to_string(jumlahDosen);
+
+        vector<JadwalKonsultasi> pohon(jumlahDosen, JadwalKonsultasi(pola));
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            k.nim_mahasiswa = nims[i];
+            checksum += static_cast<size_t>(pohon[dosenUntuk[i] % jumlahDosen].pesan(k, mulai) - mulai);
+        }
+        double msPohon = elapsedMs(start);
+        printBenchResult("mentors.tree.book" + label, n, msPohon);
+
+        vector<JadwalScan> scan(jumlahDosen);
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            JadwalScan& jadwal = scan[dosenUntuk[i] % jumlahDosen];
+            k.nim_mahasiswa = nims[i];
+            size_t j = 0;
+            while (true) {
+                if (j == jadwal.isi.size()) jadwal.isi.emplace_back(); // Days off add full sessions
+                if (jadwal.isi[j].size() < kapasitas[j % sesiSeminggu]) break;
+                j++;
+            }
+            jadwal.sesiByNim[k.nim_mahasiswa] = j;
+            jadwal.isi[j].push_back(k);
+            checksum += j;
+        }
+        double msScan = elapsedMs(start);
+        printBenchResult("mentors.scan.book" + label, n, msScan);
+        cout << "   (" << jumlahDosen << (jumlahDosen == 1 ? " mentor" : " mentors") << ": the tree takes " << fixed
+             << setprecision(2) << msPohon / msScan << defaultfloat << "x the scan's time)\n";
+    }
+
+    cout << "   (" << JUMLAH_DOSEN << " mentors, checksum " << checksum << ")\n";
+}
+
+// Multi-threaded borrow/register scaling, 1 to 64 threads, against the real global services.
+// The same total work is split across the threads; availability is reset before each run, so
+// threads race for the same books and the run checks that no book was handed out twice.
+void benchConcurrency() {
+    const size_t JUMLAH_DOSEN = 100;
+    const size_t BUKU_PER_DOSEN = 1000;
+    const size_t JUMLAH_MAHASISWA = 64000;
+    const size_t PINJAM_PER_MAHASISWA = 2;
+
+    for (size_t d = 0; d < JUMLAH_DOSEN; d++) {
+        uint32_t id = dataDosen.add({"DSN" + to_string(d), "Dosen " + to_string(d), "Mata Kuliah"});
+        for (size_t b = 0; b < BUKU_PER_DOSEN; b++) {
+            string kode = to_string(d * BUKU_PER_DOSEN + b);
+            daftarBuku.insert({"B" + kode, "Buku " + kode, dataDosen.at(id).nama});
+        }
+    }
+    vector<Mahasiswa*> mahasiswa;
+    for (size_t i = 0; i < JUMLAH_MAHASISWA; i++) {
+        string nim = to_string(100000 + i);
+        mahasiswa.push_back(&(dataMahasiswa[nim] = Mahasiswa(nim, "rahasia", "Mahasiswa " + nim)));
+    }
+
+    for (size_t jumlahThread : {1, 2, 4, 8, 16, 32, 64}) {
+        for (size_t slot = 0; slot < daftarBuku.size(); slot++) {
+            daftarBuku.setTersedia(slot, true);
+        }
+        atomic<size_t> berhasil(0);
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> threads;
+        for (size_t t = 0; t < jumlahThread; t++) {
+            threads.emplace_back([&, t]() {
+                mt19937 rng(static_cast<unsigned>(t * 7919 + jumlahThread));
+                size_t sukses = 0;
+                for (size_t i = t; i < JUMLAH_MAHASISWA; i += jumlahThread) {
+                    Mahasiswa& mhs = *mahasiswa[i];
+                    size_t dosen = rng() % JUMLAH_DOSEN;
+                    daftarKonsultasi(mhs, "DSN" + to_string(dosen));
+                    for (size_t p = 0; p < PINJAM_PER_MAHASISWA; p++) {
+                        size_t slot;
+                        string id = "B" + to_string(dosen * BUKU_PER_DOSEN + rng() % BUKU_PER_DOSEN);
+                        if (pinjamBuku(mhs, id, mhs.dosen_konsultasi_terdaftar, slot) == HasilPinjam::Berhasil) sukses++;
+                    }
+                }
+                berhasil += sukses;
+            });
+        }
+        for (thread& th : threads) th.join();
+        double ms = elapsedMs(start);
+
+        size_t dipinjam = 0;
+        for (size_t slot = 0; slot < daftarBuku.size(); slot++) {
+            dipinjam += !daftarBuku.isTersedia(slot);
+        }
+        size_t ops = JUMLAH_MAHASISWA * (1 + PINJAM_PER_MAHASISWA);
+        printBenchResult("concurrency.threads=" + to_string(jumlahThread), ops, ms);
+        cout << "   borrowed=" << berhasil.load() << " books_unavailable=" << dipinjam
+             << (berhasil.load() == dipinjam ? " (no double borrow)" : " (MISMATCH)") << "\n";
+    }
+}
+
+#ifdef __linux__
+// Persistence at scale: 1M students with 10M history entries. Writes a synthetic snapshot and a
+// WAL tail into a temporary data directory, measures WAL appends with group commit, then starts
+// a fresh process on the directory and times it up to its first answered command.
+void benchPersistence() {
+    const size_t JUMLAH_MAHASISWA = 1000000;
+    const size_t RIWAYAT_PER_MAHASISWA = 10; // Half loans, half activities
+    const size_t REKAMAN_WAL = 20000;
+    const size_t LOOKUP = 100000;
+
+    if (dataDosen.size() == 0) initializeData(); // Catalog section of the snapshot
+    char templat[] = "/tmp/smartstudent-bench-XXXXXX";
+    if (mkdtemp(templat) == nullptr) {
+        cerr << "Direktori sementara tidak dapat dibuat.\n";
+        return;
+    }
+    string dir = templat;
+    string pathSnapshot = dir + "/snapshot.bin";
+
+    auto nimKe = [](size_t i) { return to_string(1000000 + i); };
+    int64_t waktu = LayananWaktu::sekarang();
+    auto start = chrono::steady_clock::now();
+    {
+        PenulisSnapshot out;
+        out.buka(pathSnapshot);
+        PenulisBiner rekaman;
+        for (size_t i = 0; i < JUMLAH_MAHASISWA; i++) {
+            Mahasiswa mhs(nimKe(i), "rahasia", "Mahasiswa " + nimKe(i));
+            for (size_t j = 0; j < RIWAYAT_PER_MAHASISWA / 2; j++) {
+                Aktivitas pinjam{waktu, static_cast<uint32_t>((i + j) % daftarBuku.size()), JenisAktivitas::PinjamBuku};
+                mhs.riwayat_peminjaman.add(pinjam);
+                mhs.riwayat_aktivitas.add(pinjam);
+            }
+            rekaman.data.clear();
+            encodeMahasiswa(rekaman, mhs);
+            out.tambahMahasiswa(mhs.nim, rekaman.data.data(), rekaman.data.size());
+        }
+        out.mulaiKatalog();
+        rekaman.data.clear();
+        encodeKatalog(rekaman);
+        out.tulis(rekaman.data.data(), rekaman.data.size());
+        out.selesai(0);
+    }
+    printBenchResult("persistence.snapshot_write", JUMLAH_MAHASISWA, elapsedMs(start));
+    struct stat st;
+    stat(pathSnapshot.c_str(), &st);
+    cout << "   (snapshot " << st.st_size / (1024 * 1024) << " MiB, "
+         << JUMLAH_MAHASISWA * RIWAYAT_PER_MAHASISWA << " history entries)\n";
+
+    // Fresh process on the directory: map the snapshot, load the catalog, replay the WAL tail and
+    // answer a login. Run once before any WAL record exists and once with the full tail.
+    auto ukurStartup = [&](const string& label) {
+        char exe[4096];
+        ssize_t panjang = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+        if (panjang <= 0) return;
+        exe[panjang] = '\0';
+        string pathPerintah = dir + "/perintah.txt";
+        ofstream(pathPerintah) << "login " << nimKe(JUMLAH_MAHASISWA / 2) << " rahasia\nhistory activity\n";
+        string perintah = "'" + string(exe) + "' --data " + dir + " --batch " + pathPerintah + " 2>/dev/null";
+        auto mulai = chrono::steady_clock::now();
+        FILE* proses = popen(perintah.c_str(), "r");
+        char baris[65536];
+        bool ok = proses != nullptr && fgets(baris, sizeof(baris), proses) != nullptr && strstr(baris, "\"ok\":true");
+        double msPertama = elapsedMs(mulai);
+        while (proses != nullptr && fgets(baris, sizeof(baris), proses) != nullptr) {}
+        if (proses != nullptr) pclose(proses);
+        printBenchResult("persistence.startup_to_first_reply." + label, JUMLAH_MAHASISWA, msPertama, 1);
+        cout << "   (" << (ok ? "login ok" : "LOGIN FAILED") << ")\n";
+        unlink(pathPerintah.c_str());
+    };
+    ukurStartup("wal=0");
+
+    {
+        int fd = open((dir + "/wal.log").c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        WriteAheadLog wal(fd, 0, 0);
+        for (size_t jumlahThread : {1, 8}) {
+            size_t syncAwal = wal.sync();
+            start = chrono::steady_clock::now();
+            vector<thread> threads;
+            for (size_t t = 0; t < jumlahThread; t++) {
+                threads.emplace_back([&, t]() {
+                    mt19937 rng(static_cast<unsigned>(t + 1));
+                    for (size_t i = t; i < REKAMAN_WAL; i += jumlahThread) {
+                        PenulisBiner event;
+                        event.str(nimKe(rng() % JUMLAH_MAHASISWA));
+                        event.u8(static_cast<uint8_t>(JenisAktivitas::DaftarKonsultasi));
+                        event.u64(static_cast<uint64_t>(waktu));
+                        event.u32(0);
+                        wal.append(TipeWal::Aktivitas, event);
+                    }
+                });
+            }
+            for (thread& th : threads) th.join();
+            wal.flush();
+            printBenchResult("persistence.wal_append.threads=" + to_string(jumlahThread), REKAMAN_WAL, elapsedMs(start));
+            cout << "   (" << wal.sync() - syncAwal << " group commits)\n";
+        }
+
+        // Interactive path: every event waits for its own sync
+        const size_t SYNC_N = 1000;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < SYNC_N; i++) {
+            PenulisBiner event;
+            event.str(nimKe(i));
+            event.u8(static_cast<uint8_t>(JenisAktivitas::DaftarKonsultasi));
+            event.u64(static_cast<uint64_t>(waktu));
+            event.u32(0);
+            wal.tunggu(wal.append(TipeWal::Aktivitas, event));
+        }
+        printBenchResult("persistence.wal_append_durable", SYNC_N, elapsedMs(start));
+    }
+    ukurStartup("wal=" + to_string(REKAMAN_WAL * 2 + 1000));
+
+    // In-process: open the mapping, then look up and decode random students
+    SnapshotTerpetakan snapshot;
+    start = chrono::steady_clock::now();
+    snapshot.buka(pathSnapshot);
+    printBenchResult("persistence.snapshot_map", JUMLAH_MAHASISWA, elapsedMs(start), 1);
+    mt19937 rng(42);
+    size_t checksum = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < LOOKUP; i++) {
+        PembacaBiner in = snapshot.cariRekaman(nimKe(rng() % JUMLAH_MAHASISWA));
+        Mahasiswa mhs;
+        if (in.ok && decodeMahasiswa(in, mhs)) checksum += mhs.riwayat_aktivitas.size();
+    }
+    printBenchResult("persistence.lookup_materialize", LOOKUP, elapsedMs(start));
+    cout << "   (checksum " << checksum << ")\n";
+
+    snapshot.tutup();
+    unlink(pathSnapshot.c_str());
+    unlink((dir + "/wal.log").c_str());
+    rmdir(dir.c_str());
+}
+#endif
+
+#ifndef _WIN32
+// Bulk CSV import: writes mentor, student and book files into a temporary directory and loads
+// them into fresh structures, 10^5 to 10^7 books. Book rows are in random title order, so the
+// bulk build has to sort; peak memory is reported after each size.
+void benchImport() {
+    const size_t JUMLAH_DOSEN = 1000;
+    const size_t JUMLAH_MAHASISWA = 1000000;
+
+    char templat[] = "/tmp/smartstudent-import-XXXXXX";
+    if (mkdtemp(templat) == nullptr) {
+        cerr << "Direktori sementara tidak dapat dibuat.\n";
+        return;
+    }
+    string dir = templat;
+    auto petaRss = []() {
+        rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+        return static_cast<size_t>(ru.ru_maxrss) / 1024; // KiB on Linux
+    };
+
+    {
+        ofstream out(dir + "/dosen.csv");
+        out << "id,nama,mata_kuliah\n";
+        for (size_t d = 0; d < JUMLAH_DOSEN; d++) out << "DSN" << d << ",Dosen " << d << ",Mata Kuliah " << d % 40 << "\n";
+        ofstream outMhs(dir + "/mahasiswa.csv");
+        outMhs << "nim,password,nama\n";
+        for (size_t i = 0; i < JUMLAH_MAHASISWA; i++) outMhs << 1000000 + i << ",rahasia" << i % 97 << ",Mahasiswa " << i << "\n";
+    }
+
+    RegistriDosen registri;
+    map<string, Mahasiswa> mahasiswa;
+    size_t ditolak = 0;
+    PetaBerkas berkasDosen, berkasMahasiswa;
+    berkasDosen.buka(dir + "/dosen.csv");
+    berkasMahasiswa.buka(dir + "/mahasiswa.csv");
+    auto start = chrono::steady_clock::now();
+    size_t n = imporDosen(berkasDosen, registri, ditolak);
+    printBenchResult("import.dosen", n, elapsedMs(start));
+    start = chrono::steady_clock::now();
+    n = imporMahasiswa(berkasMahasiswa, mahasiswa, ditolak);
+    printBenchResult("import.mahasiswa", n, elapsedMs(start));
+
+    for (size_t jumlahBuku : {100000, 1000000, 10000000}) {
+        string path = dir + "/buku.csv";
+        {
+            ofstream out(path);
+            out << "id,judul,dosen_id\n";
+            mt19937 rng(7);
+            vector<size_t> urutan(jumlahBuku);
+            for (size_t i = 0; i < jumlahBuku; i++) urutan[i] = i;
+            shuffle(urutan.begin(), urutan.end(), rng);
+            for (size_t i : urutan) {
+                out << "B" << i << "," << judulSintetis(rng, i) << ",DSN" << i % JUMLAH_DOSEN << "\n";
+            }
+        }
+        {
+            KatalogBuku katalog;
+            PetaBerkas berkas;
+            berkas.buka(path);
+            start = chrono::steady_clock::now();
+            n = imporBuku(berkas, registri, katalog, ditolak);
+            double ms = elapsedMs(start);
+            printBenchResult("import.buku", n, ms);
+            cout << "   (" << fixed << setprecision(0) << n * 1000.0 / ms << " rows/s, "
+                 << berkas.size() / (1024 * 1024) << " MiB file, peak RSS " << petaRss() << " MiB)\n";
+            cout.unsetf(ios::floatfield);
+        }
+        unlink(path.c_str());
+    }
+    cout << "   (" << ditolak << " rows rejected, " << registri.size() << " mentors, "
+         << mahasiswa.size() << " students)\n";
 
-// ===============================================
-//           CAMPUS NAVIGATION SERVICE FUNCTIONS
-// ===============================================
+    unlink((dir + "/dosen.csv").c_str());
+    unlink((dir + "/mahasiswa.csv").c_str());
+    rmdir(dir.c_str());
+}
+#endif
 
-void displayRoute(const string& stationName) {
-    if (ruteKampus.count(stationName)) { // Check if station exists in map
-        clearScreen();
-        displayHeader();
-        cout << "   " << stationName << " ke " << KAMPUS_CAKRAWALA << "\n\n";
-        
-        int step = 1;
-        for (const string& jalur : ruteKampus[stationName]) {
-            cout << "   " << step++ << ". " << jalur << endl;
-        }
-        cout << endl;
-    } else {
-        cout << "\n   Rute dari stasiun tersebut belum tersedia.\n";
+int runBenchmarks(const string& name) {
+    bool ran = false;
+    if (name == "all" || name == "linkedlist") { benchLinkedList(); ran = true; }
+    if (name == "all" || name == "clock") { benchClock(); ran = true; }
+    if (name == "all" || name == "search") { benchSearch(); ran = true; }
+    if (name == "all" || name == "recommend") { benchRecommend(); ran = true; }
+    if (name == "all" || name == "routing") { benchRouting(); ran = true; }
+    if (name == "all" || name == "scan") { benchScanKernel(); ran = true; }
+    if (name == "all" || name == "mentors") { benchMentorQueues(); ran = true; }
+    if (name == "all" || name == "concurrency") { benchConcurrency(); ran = true; }
+    if (name == "all" || name == "metrics") { benchMetrics(); ran = true; }
+    if (name == "all" || name == "services") { benchServices(); ran = true; }
+    if (name == "all" || name == "loans") { benchLoans(); ran = true; }
+    if (name == "all" || name == "holds") { benchHolds(); ran = true; }
+#ifdef __linux__
+    if (name == "all" || name == "persistence") { benchPersistence(); ran = true; }
+#endif
+#ifndef _WIN32
+    if (name == "all" || name == "import") { benchImport(); ran = true; }
+#endif
+
+    if (!ran) {
+        cerr << "Benchmark tidak dikenal: " << name << "\n";
+        cerr << "Tersedia: all, linkedlist, clock, search, recommend, routing, scan, mentors, concurrency, metrics, services, loans, holds, persistence, import\n";
+        return 1;
     }
-    pressEnterToContinue();
+    return 0;
 }
 
 // ===============================================
-//           CONSOLE UI FUNCTIONS
+//           WORKLOAD SIMULATOR
 // ===============================================
 
-void displayLoginMenu() {
-    string nim, password;
-    bool loggedIn = false;
-    string errorMessage = "";
+// Run with: ./smartstudent --simulate <students> [threads] [seed] [phases.csv]
+// Replays a semester of traffic in-process. N synthetic students (the service benchmark's
+// generators: N / 1000 mentors, at least 10, and N / 2 books) are split over the worker threads;
+// each thread walks its students through sessions of batch commands (runBatchCommand, as the
+// server does), choosing every next step with a seeded RNG. Phases run one after another, and each
+// reports throughput, latency percentiles per operation and peak RSS while it ran.
+//
+// phases.csv: fase,sesi,dari,konsultasi,antrean,cari,pinjam,riwayat,logout
+// Each row gives the weights of the step that follows `dari` (login, konsultasi, antrean, cari,
+// pinjam or riwayat) in that phase; states without a row use the phase's login row. `sesi` is
+// the number of sessions per student in the phase (read from its first row). Library steps of a
+// student without a mentor register a consultation first, as the main menu requires.
 
-    while (!loggedIn) {
-        clearScreen();
-        displayHeader();
+enum class LangkahSim : uint8_t { Login, Konsultasi, Antrean, Cari, Pinjam, Riwayat, Logout, Jumlah };
 
-        if (!errorMessage.empty()) {
-            cout << "   !!!" << errorMessage << "\n\n";
-            errorMessage = "";
-        }
-        
-        cout << "   LOGIN\n\n";
-        cout << "   > Username (NIM) : ";
-        cin >> nim;
-        cout << "   > Password       : ";
-        cin >> password;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer
+const size_t JUMLAH_LANGKAH = static_cast<size_t>(LangkahSim::Jumlah);
+const char* const NAMA_LANGKAH[JUMLAH_LANGKAH] = {"login", "konsultasi", "antrean", "cari", "pinjam", "riwayat", "logout"};
 
-        // Call login function
-        bool loginSuccess = false;
-        auto it = dataMahasiswa.find(nim);
-        if (it != dataMahasiswa.end() && it->second.password == password) {
-            currentUser = &(it->second);
-            loginSuccess = true;
-        } else {
-            currentUser = nullptr; // Ensure currentUser is null on failed login
-        }
+struct FaseSimulasi {
+    string nama;
+    size_t sesi = 1;
+    double bobot[JUMLAH_LANGKAH][JUMLAH_LANGKAH] = {}; // [dari][ke]
+    bool adaBaris[JUMLAH_LANGKAH] = {};
 
-        if (loginSuccess) {
-            loggedIn = true;
-            cout << "\n   Login berhasil! Selamat datang, " << currentUser->nama << "!\n";
-            pressEnterToContinue();
-        } else {
-            errorMessage = "Username / Password yang anda masukkan salah."; // Set error message
-        }
+    // Weights of the step after `dari`, falling back to the login row
+    const double* baris(LangkahSim dari) const {
+        size_t i = static_cast<size_t>(dari);
+        return adaBaris[i] ? bobot[i] : bobot[static_cast<size_t>(LangkahSim::Login)];
     }
-}
+};
 
-void displayMainMenu() {
-    int choice;
-    do {
-        clearScreen();
-        displayHeader();
-        cout << "   Selamat datang di portal Smart.Student, " << currentUser->nama << "\n\n";
-        cout << "      1. > Konsultasi Akademik\n";
-        cout << "      2. > Perpustakaan\n";
-        cout << "      3. > Riwayat Peminjaman\n";
-        cout << "      4. > Riwayat Aktivitas\n";
-        cout << "      5. > Navigasi Kampus\n";
-        cout << "      6. > Logout\n";
-        cout << "\n   Pilih Menu (1 - 6) = ";
-        cin >> choice;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+// Registration week, a regular stretch of lectures, then the borrowing rush before exams
+const char* const FASE_BAWAAN =
+    "fase,sesi,dari,konsultasi,antrean,cari,pinjam,riwayat,logout\n"
+    "registrasi,1,login,8,1,0,0,1,0\n"
+    "registrasi,1,konsultasi,0,5,0,0,1,4\n"
+    "registrasi,1,antrean,0,1,0,0,0,4\n"
+    "registrasi,1,riwayat,0,0,0,0,0,1\n"
+    "perkuliahan,2,login,0,2,3,1,2,1\n"
+    "perkuliahan,2,cari,0,0,2,3,1,3\n"
+    "perkuliahan,2,pinjam,0,0,1,0,2,4\n"
+    "perkuliahan,2,antrean,0,0,1,0,0,3\n"
+    "perkuliahan,2,riwayat,0,0,1,0,0,3\n"
+    "ujian,3,login,0,0,4,4,1,0\n"
+    "ujian,3,cari,0,0,2,6,0,2\n"
+    "ujian,3,pinjam,0,0,3,3,1,3\n"
+    "ujian,3,riwayat,0,0,0,0,0,1\n";
 
-        switch (choice) {
-            case 1: KonsultasiAkademikMenu(); break;
-            case 2: 
-                if (!currentUser->sudah_daftar_konsultasi) {
-                    clearScreen();
-                    displayHeader();
-                    cout << "   !!! Anda harus memilih dosen untuk konsultasi akademik terlebih dahulu.\n\n";
-                    pressEnterToContinue();
-                } else {
-                    PerpustakaanMenu(); 
-                }
-                break;
-            case 3: RiwayatPeminjamanMenu(); break;
-            case 4: RiwayatAktivitasMenu(); break;
-            case 5: NavigasiKampusMenu(); break;
-            case 6:
-                cout << "\n" << "   " << currentUser->nama << " berhasil logout.\n";
-                pressEnterToContinue();
-                currentUser = nullptr; // Reset current user
-                break;
-            default:
-                cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
-                pressEnterToContinue();
-                break;
-        }
-    } while (currentUser != nullptr);
+// A whole string as a decimal count; false for an empty string, a sign, trailing characters or
+// a value out of range (phase files and command-line counts)
+bool bacaBilangan(const string& teks, size_t& nilai) {
+    if (teks.empty() || teks[0] < '0' || teks[0] > '9') return false;
+    errno = 0;
+    char* akhir = nullptr;
+    unsigned long long v = strtoull(teks.c_str(), &akhir, 10);
+    if (errno == ERANGE || *akhir != '\0' || v > numeric_limits<size_t>::max()) return false;
+    nilai = static_cast<size_t>(v);
+    return true;
 }
 
-void KonsultasiAkademikMenu() {
-    clearScreen();
-    displayHeader();
-    cout << "   Antrean Konsultasi Akademik\n\n";
+// A whole string as a transition weight: finite and not negative
+bool bacaBobot(const string& teks, double& nilai) {
+    if (teks.empty()) return false;
+    char* akhir = nullptr;
+    double v = strtod(teks.c_str(), &akhir);
+    if (*akhir != '\0' || !isfinite(v) || v < 0) return false;
+    nilai = v;
+    return true;
+}
 
-    // Check user's current consultation status and display detailed queue if applicable
-    // This call will set currentUser->sudah_daftar_konsultasi and dosen_konsultasi_terdaftar
-    displayDetailedConsultationQueue(currentUser->nim); 
+// Parses phase rows in file order; prints the first bad line to stderr and returns false
+bool bacaFaseSimulasi(istream& in, vector<FaseSimulasi>& fase) {
+    string line;
+    size_t nomor = 0;
+    while (getline(in, line)) {
+        nomor++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#' || line.compare(0, 5, "fase,") == 0) continue;
 
-    if (currentUser->sudah_daftar_konsultasi) {
-        // Message and press enter are handled inside displayDetailedConsultationQueue
-        pressEnterToContinue(); // Ensure the "Press Enter to continue" is shown after the queue info
-        return; 
+        vector<string> kolom;
+        stringstream baris(line);
+        for (string k; getline(baris, k, ',');) kolom.push_back(k);
+        size_t dari = 0;
+        while (dari < JUMLAH_LANGKAH && (kolom.size() < 3 || kolom[2] != NAMA_LANGKAH[dari])) dari++;
+        size_t sesi = 0;
+        double bobot[JUMLAH_LANGKAH] = {};
+        bool valid = kolom.size() == 3 + JUMLAH_LANGKAH - 1 && dari < static_cast<size_t>(LangkahSim::Logout) &&
+                     bacaBilangan(kolom[1], sesi);
+        for (size_t ke = 1; valid && ke < JUMLAH_LANGKAH; ke++) valid = bacaBobot(kolom[2 + ke], bobot[ke]);
+        if (!valid) {
+            cerr << "Baris fase tidak valid (" << nomor << "): " << line << "\n";
+            return false;
+        }
+        if (fase.empty() || fase.back().nama != kolom[0]) {
+            fase.emplace_back();
+            fase.back().nama = kolom[0];
+            fase.back().sesi = sesi;
+        }
+        FaseSimulasi& f = fase.back();
+        f.adaBaris[dari] = true;
+        for (size_t ke = 1; ke < JUMLAH_LANGKAH; ke++) f.bobot[dari][ke] = bobot[ke];
     }
+    return true;
+}
 
-    // Display available mentors table ONLY if student is NOT already registered
-    cout << string(92, '-') << endl;
-    cout << left << setw(15) << "ID Dosen"
-              << setw(25) << "Nama Dosen"
-              << setw(40) << "Mata Kuliah" << endl;
-    cout << string(92, '-') << endl;
-    for (const auto& pair : dataDosen) { // Iterate through dataDosen map
-        cout << left << setw(15) << pair.second.id
-                  << setw(25) << pair.second.nama
-                  << setw(40) << pair.second.mata_kuliah << endl;
+// Peak RSS in KiB since the last reset. Linux resets the peak through clear_refs; elsewhere the
+// value is the peak of the whole process (0 on Windows, where it is not measured).
+size_t rssPuncakKiB() {
+#ifdef __linux__
+    ifstream status("/proc/self/status");
+    for (string line; getline(status, line);) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return stoul(line.substr(6));
     }
-    cout << endl;
-
-    // Menu options for new registration
-    int choice;
-    cout << "      1. > Daftarkan Konsultasi\n";
-    cout << "      2. > Lihat Antrean\n"; // This option now just calls the display function again
-    cout << "      3. > Kembali\n";
-    cout << "\n   Pilih Menu (1 - 3) = ";
-    cin >> choice;
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+#endif
+#ifndef _WIN32
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return static_cast<size_t>(ru.ru_maxrss) / 1024; // Bytes on macOS
+#else
+    return static_cast<size_t>(ru.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
 
-    if (choice == 1) { // Register Consultation
-        string idDosenInput;
-        cout << "\n   Masukkan ID Dosen yang dipilih untuk konsultasi: ";
-        cin >> idDosenInput;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        registerConsultationLogic(idDosenInput); // Calls the service logic
-    } else if (choice == 2) { // View Queue
-        clearScreen();
-        displayHeader();
-        cout << "   Lihat Antrean Konsultasi Akademik\n\n";
-        displayDetailedConsultationQueue(currentUser->nim); // Re-use the existing logic to show user's queue
-        pressEnterToContinue(); // Press enter after viewing the queue
-    } else if (choice == 3) {
-        // Return to main menu
-    } else {
-        cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
-        pressEnterToContinue();
-    }
+void resetRssPuncak() {
+#ifdef __linux__
+    ofstream("/proc/self/clear_refs") << "5";
+#endif
 }
 
-void PerpustakaanMenu() {
-    string dosenRujukan = currentUser->dosen_konsultasi_terdaftar;
-    set<Buku> currentDisplayBuku; 
+int runSimulasi(size_t jumlahMahasiswa, size_t jumlahThread, unsigned seed, const string& berkasFase) {
+    const size_t LANGKAH_MAKS = 64; // Per session, in case a phase never weights logout
+    const char* KATA_KUNCI[] = {"python", "data", "sistem", "jaringan", "algoritma", "web", "jilid 1"};
 
-    // Initialize currentDisplayBuku with all books from the relevant mentor on entry
-    for (const auto& buku : daftarBuku) {
-        if (buku.dosen_referensi == dosenRujukan) {
-            currentDisplayBuku.insert(buku);
+    vector<FaseSimulasi> fase;
+    bool valid;
+    if (berkasFase.empty()) {
+        istringstream in(FASE_BAWAAN);
+        valid = bacaFaseSimulasi(in, fase);
+    } else {
+        ifstream in(berkasFase);
+        if (!in) {
+            cerr << "File fase tidak dapat dibuka: " << berkasFase << "\n";
+            return 1;
         }
+        valid = bacaFaseSimulasi(in, fase);
+    }
+    if (!valid) return 1;
+    if (fase.empty() || jumlahMahasiswa == 0 || jumlahThread == 0) {
+        cerr << "Simulasi membutuhkan mahasiswa, thread dan minimal satu fase.\n";
+        return 1;
     }
-    
-    do { 
-        clearScreen();
-        displayHeader();
-        cout << "   Daftar buku perpustakaan rujukan (" << dosenRujukan << ")\n\n";
 
-        displayBooksTable(currentDisplayBuku);
+    size_t jumlahDosen = max<size_t>(10, jumlahMahasiswa / 1000);
+    auto start = chrono::steady_clock::now();
+    generateDosen(0, jumlahDosen);
+    generateMahasiswa(0, jumlahMahasiswa);
+    generateBuku(0, max<size_t>(1, jumlahMahasiswa / 2), jumlahDosen, seed);
+    cout << "Simulasi: " << jumlahMahasiswa << " mahasiswa, " << jumlahDosen << " dosen, " << daftarBuku.size()
+         << " buku, " << jumlahThread << " thread, seed " << seed << " (data siap dalam "
+         << fixed << setprecision(1) << elapsedMs(start) << " ms)\n";
+    cout.unsetf(ios::floatfield);
 
-        cout << "      1. > Pinjam Buku\n";
-        cout << "      2. > Cari Buku\n";
-        cout << "      3. > Filter Buku (Tersedia)\n";
-        cout << "      4. > Reset Filter\n"; 
-        cout << "      5. > Kembali ke Menu Utama\n"; 
-        cout << "\n   Pilih Menu (1 - 5) = ";
-        int subChoice;
-        cin >> subChoice;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    // Mentor index per student once registered (-1 before); only the thread serving a student
+    // touches its entry, and phases are separated by joins
+    vector<int32_t> dosenMahasiswa(jumlahMahasiswa, -1);
 
-        string inputId;
-        string keyword;
+    for (size_t f = 0; f < fase.size(); f++) {
+        const FaseSimulasi& fs = fase[f];
+        vector<MetrikOperasi::Ringkasan> sebelum;
+        for (size_t i = 0; i < MetrikOperasi::JUMLAH_OPERASI; i++) sebelum.push_back(metrikOperasi.baca(static_cast<Operasi>(i)));
+        resetRssPuncak();
+        atomic<size_t> totalPerintah(0), totalGagal(0);
 
-        switch (subChoice) {
-            case 1: { // Pinjam Buku
-                cout << "   Masukkan ID Buku yang dipilih : ";
-                cin >> inputId;
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                borrowBook(inputId, dosenRujukan); 
-                
-                // Refresh display after action: reset currentDisplayBuku to all books for this mentor
-                currentDisplayBuku.clear();
-                for (const auto& buku : daftarBuku) {
-                    if (buku.dosen_referensi == dosenRujukan) {
-                        currentDisplayBuku.insert(buku);
-                    }
-                }
-                break;
-            }
-            case 2: { // Cari Buku
-                cout << "   Masukkan keyword buku: ";
-                getline(cin, keyword);
-                currentDisplayBuku = searchBooks(keyword, dosenRujukan); 
-                break;
-            }
-            case 3: { // Filter Buku (Tersedia)
-                currentDisplayBuku = filterAvailableBooks(dosenRujukan); 
-                break;
-            }
-            case 4: { // Reset Filter
-                currentDisplayBuku.clear();
-                for (const auto& buku : daftarBuku) {
-                    if (buku.dosen_referensi == dosenRujukan) {
-                        currentDisplayBuku.insert(buku);
+        start = chrono::steady_clock::now();
+        vector<thread> threads;
+        for (size_t t = 0; t < jumlahThread; t++) {
+            threads.emplace_back([&, t]() {
+                mt19937 rng(seed + static_cast<unsigned>(f * 1000003 + t * 7919));
+                size_t perintah = 0, gagal = 0;
+                Mahasiswa* sesi = nullptr;
+                auto kirim = [&](const string& line) {
+                    perintah++;
+                    if (runBatchCommand(line, sesi).find("\"ok\":false") != string::npos) gagal++;
+                };
+                auto pilih = [&](const double* bobot) {
+                    double total = 0;
+                    for (size_t ke = 1; ke < JUMLAH_LANGKAH; ke++) total += bobot[ke];
+                    double r = uniform_real_distribution<double>(0, total)(rng);
+                    for (size_t ke = 1; ke < JUMLAH_LANGKAH; ke++) {
+                        if (r < bobot[ke]) return static_cast<LangkahSim>(ke);
+                        r -= bobot[ke];
                     }
-                }
-                break;
-            }
-            case 5: // Kembali ke Menu Utama
-                return; 
-            default:
-                cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
-                pressEnterToContinue();
-                // On invalid input, reset display to all books for this mentor
-                currentDisplayBuku.clear();
-                for (const auto& buku : daftarBuku) {
-                    if (buku.dosen_referensi == dosenRujukan) {
-                        currentDisplayBuku.insert(buku);
+                    return LangkahSim::Logout;
+                };
+
+                for (size_t putaran = 0; putaran < fs.sesi; putaran++) {
+                    for (size_t i = t; i < jumlahMahasiswa; i += jumlahThread) {
+                        string nomor = to_string(i);
+                        int32_t& dosen = dosenMahasiswa[i];
+                        kirim("login S" + nomor + " pw" + nomor);
+                        LangkahSim langkah = LangkahSim::Login;
+                        for (size_t n = 0; n < LANGKAH_MAKS; n++) {
+                            langkah = pilih(fs.baris(langkah));
+                            if (langkah == LangkahSim::Logout) break;
+                            bool perluDosen = langkah == LangkahSim::Cari || langkah == LangkahSim::Pinjam;
+                            if (dosen < 0 && (langkah == LangkahSim::Konsultasi || perluDosen)) {
+                                dosen = static_cast<int32_t>(rng() % jumlahDosen);
+                                kirim("register-consultation SDSN" + to_string(dosen));
+                                if (langkah == LangkahSim::Konsultasi) continue;
+                            }
+                            switch (langkah) {
+                                case LangkahSim::Konsultasi:
+                                case LangkahSim::Antrean:
+                                    kirim("queue");
+                                    break;
+                                case LangkahSim::Cari:
+                                    kirim(string("search ") + KATA_KUNCI[rng() % (sizeof(KATA_KUNCI) / sizeof(KATA_KUNCI[0]))]);
+                                    break;
+                                case LangkahSim::Pinjam: {
+                                    // Skewed toward the first books of the mentor, so popular titles run out
+                                    const vector<size_t>& milik = daftarBuku.slotsByDosen("Dosen S" + to_string(dosen));
+                                    if (milik.empty()) break;
+                                    double u = uniform_real_distribution<double>(0, 1)(rng);
+                                    kirim("borrow " + daftarBuku.at(milik[static_cast<size_t>(u * u * u * milik.size())]).id);
+                                    break;
+                                }
+                                case LangkahSim::Riwayat:
+                                    kirim(rng() % 2 ? "history loans" : "history activity");
+                                    break;
+                                default:
+                                    break;
+                            }
+                        }
+                        kirim("logout");
                     }
                 }
-                break;
+                totalPerintah += perintah;
+                totalGagal += gagal;
+            });
         }
-    } while (true);
-}
-
-void RiwayatPeminjamanMenu() {
-    clearScreen();
-    displayHeader();
-    cout << "   Riwayat peminjaman buku " << currentUser->nama << "\n\n";
-
-    if (currentUser->riwayat_peminjaman.isEmpty()) {
-        cout << "   !!! Belum meminjam buku apapun.\n";
-    } else {
-        cout << string(92, '-') << endl;
-        cout << left << setw(20) << "Tanggal"
-                  << setw(50) << "Judul Buku" << endl;
-        cout << string(92, '-') << endl;
+        for (thread& th : threads) th.join();
+        double ms = elapsedMs(start);
 
-        Node<pair<string, string>>* current = currentUser->riwayat_peminjaman.getHead();
-        while (current != nullptr) {
-            cout << left << setw(20) << current->data.first
-                      << setw(50) << current->data.second << endl;
-            current = current->next;
+        vector<MetrikOperasi::Ringkasan> ringkasan;
+        for (size_t i = 0; i < MetrikOperasi::JUMLAH_OPERASI; i++) {
+            ringkasan.push_back(metrikOperasi.baca(static_cast<Operasi>(i)).selisih(sebelum[i]));
         }
+        cout << "\nFase " << fs.nama << ": " << jumlahMahasiswa * fs.sesi << " sesi, " << totalPerintah.load()
+             << " perintah (" << totalGagal.load() << " ditolak) dalam " << fixed << setprecision(1) << ms << " ms, "
+             << setprecision(0) << (ms > 0 ? totalPerintah.load() * 1000.0 / ms : 0.0) << " perintah/detik, RSS puncak "
+             << rssPuncakKiB() / 1024 << " MiB\n";
+        cout.unsetf(ios::floatfield);
+        cout << tabelMetrikTeks(ringkasan);
     }
-    cout << endl;
-    pressEnterToContinue();
+    return 0;
 }
 
-void RiwayatAktivitasMenu() {
-    clearScreen();
-    displayHeader();
-    cout << "   Riwayat aktivitas " << currentUser->nama << "\n\n";
-
-    if (currentUser->riwayat_aktivitas.isEmpty()) {
-        cout << "   Belum melakukan aktivitas apapun.\n";
-    } else {
-        cout << string(92, '-') << endl;
-        cout << left << setw(20) << "Tanggal"
-                  << setw(60) << "Riwayat Aktivitas" << endl;
-        cout << string(92, '-') << endl;
+// ===============================================
+//           MAIN FUNCTION
+// ===============================================
 
-        Node<pair<string, string>>* current = currentUser->riwayat_aktivitas.getHead();
-        while (current != nullptr) {
-            cout << left << setw(20) << current->data.first
-                      << setw(60) << current->data.second << endl;
-            current = current->next;
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "--bench") {
+        string nama = "all";
+        for (int i = 2; i < argc; i++) {
+            string opsi = argv[i];
+            if (opsi == "--format" && i + 1 < argc) {
+                string format = argv[++i];
+                if (format == "text") formatBench = FormatBench::Teks;
+                else if (format == "csv") formatBench = FormatBench::Csv;
+                else if (format == "json") formatBench = FormatBench::Json;
+                else {
+                    cerr << "Format tidak dikenal: " << format << " (text, csv, json)\n";
+                    return 1;
+                }
+            } else if (opsi == "--max" && i + 1 < argc) {
+                string maks = argv[++i];
+                if (!bacaBilangan(maks, skalaMaksBench)) {
+                    cerr << "Skala maksimum tidak valid: " << maks << " (bilangan bulat)\n";
+                    return 1;
+                }
+            } else {
+                nama = opsi;
+            }
         }
+        if (formatBench != FormatBench::Teks) {
+            // Only result rows go to stdout; headings and checksums move to stderr
+            static ostream hasil(cout.rdbuf());
+            keluaranBench = &hasil;
+            cout.rdbuf(cerr.rdbuf());
+            if (formatBench == FormatBench::Csv) hasil << "name,n,ops,total_ms,ns_per_op\n";
+        }
+        return runBenchmarks(nama);
+    }
+    if (argc >= 2 && string(argv[1]) == "--simulate") {
+        size_t mahasiswa = 0, thread = 8, seed = 1;
+        if (argc < 3 || !bacaBilangan(argv[2], mahasiswa) || (argc >= 4 && !bacaBilangan(argv[3], thread)) ||
+            (argc >= 5 && (!bacaBilangan(argv[4], seed) || seed > numeric_limits<unsigned>::max()))) {
+            cerr << "Penggunaan: " << argv[0] << " --simulate <mahasiswa> [thread] [seed] [fase.csv]\n";
+            return 1;
+        }
+        return runSimulasi(mahasiswa, thread, static_cast<unsigned>(seed), argc >= 6 ? argv[5] : "");
+    }
+    if (argc >= 2 && string(argv[1]) == "--load-client") {
+#ifdef __linux__
+        if (argc < 3) {
+            cerr << "Penggunaan: " << argv[0] << " --load-client <socket> [koneksi] [request per koneksi]\n";
+            return 1;
+        }
+        size_t koneksi = 100, request = 1000;
+        if ((argc >= 4 && !bacaBilangan(argv[3], koneksi)) || (argc >= 5 && !bacaBilangan(argv[4], request))) {
+            cerr << "Penggunaan: " << argv[0] << " --load-client <socket> [koneksi] [request per koneksi]\n";
+            return 1;
+        }
+        return runLoadClient(argv[2], koneksi, request);
+#else
+        cerr << "Load client hanya tersedia di Linux.\n";
+        return 1;
+#endif
     }
-    cout << endl;
-    pressEnterToContinue();
-}
 
-void NavigasiKampusMenu() {
-    clearScreen();
-    displayHeader();
-    cout << "   Navigasi Kampus\n\n";
+    // --data <dir> (persistence), --import <dir> (CSV data) and --metrics <file> (JSON metrics
+    // dump at exit and on SIGUSR1) may precede any mode below
+    // (argv[0] is kept for usage messages)
+    string dataDir, importDir;
+    while (argc >= 3 && (string(argv[1]) == "--data" || string(argv[1]) == "--import" || string(argv[1]) == "--metrics")) {
+        string opsi = argv[1];
+        (opsi == "--data" ? dataDir : opsi == "--import" ? importDir : berkasMetrik) = argv[2];
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
 
-    cout << "      1. > Stasiun Tebet\n";
-    cout << "      2. > Stasiun Blok M\n";
-    cout << "      3. > Stasiun Lb. Bulus\n";
-    cout << "      4. > Stasiun Tanjung Barat\n";
-    cout << "      5. > Stasiun Taman Mini\n";
-    cout << "      6. > Kembali\n"; 
-    cout << "\n   Pilih titik awal (1 - 6) = ";
+#ifdef __linux__
+    mulaiPemantauMetrik(); // Before the WAL writer or server threads start
+#endif
+    if (!berkasMetrik.empty()) {
+        atexit(dumpMetrikSaatKeluar);
+    }
 
-    int choice;
-    cin >> choice;
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    if (dataDir.empty()) {
+        if (!muatDataAwal(importDir)) { // Initialize all global data once at startup
+            return 1;
+        }
+    } else {
+#ifndef _WIN32
+        if (!mulaiPersistensi(dataDir, importDir)) {
+            return 1;
+        }
+        atexit(tutupPersistensi);
+#else
+        cerr << "Penyimpanan data (--data) belum tersedia di Windows.\n";
+        return 1;
+#endif
+    }
 
-    string selectedStation = "";
+    periksaJatuhTempo(LayananWaktu::sekarang()); // Loans and consultation days that ended while stopped
 
-    switch (choice) {
-        case 1: selectedStation = "Tebet"; break;
-        case 2: selectedStation = "Blok M"; break;
-        case 3: selectedStation = "Lb. Bulus"; break;
-        case 4: selectedStation = "Tanjung Barat"; break;
-        case 5: selectedStation = "Taman Mini"; break;
-        case 6: return; 
-        default:
-            cout << "\nPilihan tidak valid. Silakan coba lagi.\n";
-            pressEnterToContinue();
-            return;
+    if (argc >= 2 && string(argv[1]) == "--batch") {
+        if (argc >= 3) {
+            ifstream file(argv[2]);
+            if (!file) {
+                cerr << "File batch tidak dapat dibuka: " << argv[2] << "\n";
+                return 1;
+            }
+            return runBatch(file);
+        }
+        return runBatch(cin);
     }
 
-    displayRoute(selectedStation); // Call displayRoute function
-}
-
-// ===============================================
-//           MAIN FUNCTION
-// ===============================================
+    if (argc >= 2 && string(argv[1]) == "--server") {
+#ifdef __linux__
+        if (argc < 3) {
+            cerr << "Penggunaan: " << argv[0] << " --server <socket>\n";
+            return 1;
+        }
+        return runServer(argv[2]);
+#else
+        cerr << "Mode server hanya tersedia di Linux.\n";
+        return 1;
+#endif
+    }
 
-int main() {
-    initializeData(); // Initialize all global data once at startup
+    // Interactive screens are composed in one frame and written with a single write() per input prompt
+    FrameBuffer frameBuffer;
+    GantiBuffer pasangFrame(cout, &frameBuffer);
 
-    // Main application loop: handles login and then the main menu
-    while (true) {
+    // Main application loop: handles login and then the main menu, until stdin is closed
+    while (!cin.eof()) {
         displayLoginMenu(); // Manages the login process; loops until successful login
         if (currentUser != nullptr) { // If a user is successfully logged in
             displayMainMenu(); // Enter the main application menu loop
+            snapshotBilaPerlu();
         } else {
             // This part is reached if currentUser becomes nullptr (e.g., after logout)
             // It implicitly loops back to displayLoginMenu
@@ -847,4 +7921,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}